@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+
+# Copyright 2026 Daniel Estevez <daniel@destevez.net>
+#
+# This file is part of gr-satellites
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+import argparse
+import array
+import struct
+import sys
+
+
+MAGIC = b'GRSDOPPL'
+VERSION = 1
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Converts a text Doppler file to the binary format')
+    parser.add_argument(
+        'input_file', help='Input text file')
+    parser.add_argument(
+        'output_file', help='Output binary file')
+    return parser.parse_args()
+
+
+def read_text_file(path):
+    times = array.array('d')
+    freqs = array.array('d')
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if not fields:
+                continue
+            if len(fields) != 2:
+                raise RuntimeError(f'format error in Doppler file: {line!r}')
+            times.append(float(fields[0]))
+            freqs.append(float(fields[1]))
+    if not times:
+        raise RuntimeError('empty Doppler file')
+    if any(b < a for a, b in zip(times, times[1:])):
+        raise RuntimeError('timestamps in Doppler file are not sorted')
+    return times, freqs
+
+
+def slopes(times, freqs):
+    """Computes the slope (Hz/s) of the segment starting at each timestamp
+
+    The last timestamp, and any timestamp repeated in the next entry,
+    get a zero slope.
+    """
+    s = array.array('d', [0.0] * len(times))
+    for j in range(len(times) - 1):
+        dt = times[j + 1] - times[j]
+        if dt > 0:
+            s[j] = (freqs[j + 1] - freqs[j]) / dt
+    return s
+
+
+def write_binary_file(path, times, freqs):
+    header = struct.pack('<8sIIQQ', MAGIC, VERSION, 0, len(times), 0)
+    with open(path, 'wb') as f:
+        f.write(header)
+        for a in [times, freqs, slopes(times, freqs)]:
+            if sys.byteorder != 'little':
+                a = array.array('d', a)
+                a.byteswap()
+            a.tofile(f)
+
+
+def main():
+    args = parse_args()
+    write_binary_file(args.output_file, *read_text_file(args.input_file))
+
+
+if __name__ == '__main__':
+    main()
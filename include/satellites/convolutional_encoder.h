@@ -21,6 +21,14 @@ namespace satellites {
  * \brief Convolutional encoder
  * \ingroup satellites
  *
+ * Generic convolutional encoder that can use any constraint length and
+ * polynomials. Optionally, the output can be punctured with a puncturing
+ * pattern that lists, for each of the encoder output symbols in a
+ * puncturing period, whether the symbol is transmitted (1) or deleted (0).
+ *
+ * The input and output PDUs can contain unpacked bits (one bit per byte)
+ * or packed bytes (MSB first). If the number of output symbols is not a
+ * multiple of 8, the last packed output byte is padded with zeros.
  */
 class SATELLITES_API convolutional_encoder : virtual public gr::block
 {
@@ -34,8 +42,18 @@ public:
      * constructor is in a private implementation
      * class. satellites::convolutional_encoder::make is the public interface for
      * creating new instances.
+     *
+     * \param constraint Constraint length of the code
+     * \param polynomials Polynomials defining the code
+     * \param puncturing Puncturing pattern (empty for no puncturing)
+     * \param packed_input Input PDUs contain packed bytes
+     * \param packed_output Output PDUs contain packed bytes
      */
-    static sptr make(int constraint, const std::vector<int>& polynomials);
+    static sptr make(int constraint,
+                     const std::vector<int>& polynomials,
+                     const std::vector<int>& puncturing = std::vector<int>(),
+                     bool packed_input = false,
+                     bool packed_output = false);
 };
 
 } // namespace satellites
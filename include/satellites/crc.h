@@ -26,8 +26,18 @@ namespace satellites {
  *
  * \details
  * This class calculates a CRC with configurable parameters.
- * A table-driven byte-by-byte approach is used in the CRC
- * computation.
+ * The CRC is computed with the slicing-by-8 algorithm, which
+ * processes 8 bytes at a time using 8 lookup tables. On CPUs
+ * with carry-less multiplication instructions (PCLMULQDQ on
+ * x86-64, PMULL on ARMv8), long inputs are first folded into
+ * 16 bytes that give the same CRC.
+ *
+ * Besides computing the CRC of a buffer with compute(), the CRC
+ * of data split in several chunks can be computed incrementally
+ * with init(), update() and finalize(), and the CRCs of two
+ * pieces of data can be combined into the CRC of their
+ * concatenation with combine(). All the methods are const, so
+ * a crc object can be used from several threads concurrently.
  */
 class SATELLITES_API crc
 {
@@ -56,20 +66,78 @@ public:
      * \param data the input data for the CRC calculation
      * \param len the length in bytes of the data
      */
-    uint64_t compute(const uint8_t* data, std::size_t len);
+    uint64_t compute(const uint8_t* data, std::size_t len) const;
 
     /*!
      * \brief Computes a CRC
      *
      * \param data the input data for the CRC calculation
      */
-    uint64_t compute(const std::vector<uint8_t> data)
+    uint64_t compute(const std::vector<uint8_t>& data) const
     {
         return compute(data.data(), data.size());
     }
 
+    /*!
+     * \brief Returns the initial state for an incremental CRC computation
+     *
+     * The state is an opaque value that should only be passed to
+     * update() and finalize().
+     */
+    uint64_t init() const;
+
+    /*!
+     * \brief Updates the state of an incremental CRC computation
+     *
+     * \param state the current state
+     * \param data the next chunk of input data
+     * \param len the length in bytes of the chunk
+     *
+     * \return the new state
+     */
+    uint64_t update(uint64_t state, const uint8_t* data, std::size_t len) const;
+
+    /*!
+     * \brief Updates the state of an incremental CRC computation
+     *
+     * \param state the current state
+     * \param data the next chunk of input data
+     *
+     * \return the new state
+     */
+    uint64_t update(uint64_t state, const std::vector<uint8_t>& data) const
+    {
+        return update(state, data.data(), data.size());
+    }
+
+    /*!
+     * \brief Returns the CRC of the data given to an incremental computation
+     *
+     * \param state the state after the last call to update()
+     */
+    uint64_t finalize(uint64_t state) const;
+
+    /*!
+     * \brief Combines two CRCs
+     *
+     * Given the CRCs of two pieces of data A and B, returns the CRC of the
+     * concatenation of A and B.
+     *
+     * \param crc_a the CRC of A
+     * \param crc_b the CRC of B
+     * \param len_b the length in bytes of B
+     */
+    uint64_t combine(uint64_t crc_a, uint64_t crc_b, std::size_t len_b) const;
+
 private:
-    std::array<uint64_t, 256> d_table;
+    // d_tables[n][b] is the CRC register update for the byte b followed by
+    // n zero bytes. For non-reflected CRCs the register is aligned to the
+    // MSB of the 64-bit word.
+    std::array<std::array<uint64_t, 256>, 8> d_tables;
+    // Constants for the carry-less multiplication folding
+    std::array<uint64_t, 4> d_fold;
+    // Polynomial in MSB-first notation, without its x^num_bits term
+    uint64_t d_poly;
     unsigned d_num_bits;
     uint64_t d_mask;
     uint64_t d_initial_value;
@@ -77,7 +145,20 @@ private:
     bool d_input_reflected;
     bool d_result_reflected;
 
-    uint64_t reflect(uint64_t word);
+    uint64_t reflect(uint64_t word) const;
+
+    // The state of an incremental computation is the CRC register, in the
+    // format used by the tables
+    uint64_t update_tables(uint64_t rem, const uint8_t* data, std::size_t len) const;
+
+    // Galois field operations modulo the polynomial, used to combine CRCs.
+    // The MSB of the result holds the highest degree coefficient.
+    uint64_t mul_mod(uint64_t a, uint64_t b) const;
+    uint64_t xpow8n_mod(std::size_t n) const;
+    // Conversions between a CRC and the corresponding register contents as
+    // a polynomial
+    uint64_t crc_to_poly(uint64_t crc) const;
+    uint64_t poly_to_crc(uint64_t poly) const;
 };
 
 } // namespace satellites
@@ -29,6 +29,17 @@ namespace satellites {
  * or fail output ports according to the result of this check.
  * It can support any CRC whose size is a multiple of 8 bits between
  * 8 and 64 bits.
+ *
+ * Optionally, the block can correct PDUs with up to two bit errors
+ * (including errors in the CRC). A table that maps the syndrome of
+ * each single bit error to its position is built when the block is
+ * created, so single errors are found with a table lookup and double
+ * errors with one table lookup per candidate position of the first
+ * error. Corrections are only done when the error pattern is unique.
+ * Corrected PDUs are sent over the ok port, with the number of
+ * corrected bits in the crc_corrected_bits metadata field and their
+ * positions (counting bits MSB-first from the start of the PDU) in
+ * the crc_corrected_positions field.
  */
 class SATELLITES_API crc_check : virtual public gr::block
 {
@@ -50,6 +61,9 @@ public:
        it to the output port. If false, the CRC is preserved in the outupt PDU.
      * \param skip_header_bytes gives the number of header byte to skip in the CRC
        calculation
+     * \param max_bit_errors maximum number of bit errors to correct (0, 1 or 2)
+     * \param max_frame_len maximum length in bytes of the PDUs that are corrected,
+       not counting the header bytes
      */
     static sptr make(unsigned num_bits,
                      uint64_t poly,
@@ -59,7 +73,9 @@ public:
                      bool result_reflected,
                      bool swap_endianness,
                      bool discard_crc = false,
-                     unsigned skip_header_bytes = 0);
+                     unsigned skip_header_bytes = 0,
+                     unsigned max_bit_errors = 0,
+                     unsigned max_frame_len = 256);
 };
 
 } // namespace satellites
@@ -18,9 +18,24 @@ namespace gr {
 namespace satellites {
 
 /*!
- * \brief <+description of block+>
+ * \brief Reed-Solomon decoder
  * \ingroup satellites
  *
+ * \details
+ * Decodes PDUs containing (possibly interleaved and shortened)
+ * Reed-Solomon codewords, with one symbol per byte. The number of
+ * corrected symbols is added to the rs_errors metadata field.
+ *
+ * If the reliability of the received symbols is known, the decoder uses
+ * errors-and-erasures decoding when errors-only decoding fails, erasing
+ * an increasing number of the least reliable symbols, up to the number
+ * of roots. The reliabilities can be given either as an f32vector in
+ * the rs_reliability metadata field, with one element per byte of the
+ * PDU, or by using an f32vector PDU that contains soft bits, with
+ * positive values meaning a 1 bit, instead of a u8vector. In the latter
+ * case the reliability of each symbol is the smallest absolute value of
+ * its soft bits. The number of erasures used is added to the
+ * rs_erasures metadata field.
  */
 class SATELLITES_API decode_rs : virtual public gr::block
 {
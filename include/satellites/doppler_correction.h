@@ -40,7 +40,15 @@ namespace satellites {
  *
  * The Doppler correction block interpolates the frequency linearly between each
  * pair of entries in the text file, and generates a correction with continuous
- * phase.
+ * phase. The correction is generated in blocks of up to 512 samples with a
+ * VOLK rotator, and its phase is recomputed in double precision at the start of
+ * each block. The phase error with respect to an exact sample-by-sample NCO
+ * is below 1e-4 radians.
+ *
+ * Long Doppler files can be converted to a binary format with the
+ * doppler_file_to_binary.py script. Binary files are detected automatically,
+ * are memory mapped instead of parsed, and can be seeked quickly when the time
+ * is updated.
  */
 class SATELLITES_API doppler_correction : virtual public gr::sync_block
 {
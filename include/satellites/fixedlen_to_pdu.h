@@ -30,11 +30,17 @@ public:
 
     /*!
      * Make a Fixedlen to PDU block.
+     *
+     * If quantize is true, the type must be float_t, and the soft symbols
+     * are output as int8 values, computed by multiplying by scale, rounding
+     * and saturating to [-128, 127].
      */
     static sptr make(types::vector_type type,
                      const std::string& syncword_tag,
                      size_t packet_len,
-                     bool pack = false);
+                     bool pack = false,
+                     bool quantize = false,
+                     float scale = 1.0f);
 };
 
 } // namespace satellites
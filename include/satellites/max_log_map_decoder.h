@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_H
+#define INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_H
+
+#include <gnuradio/block.h>
+#include <satellites/api.h>
+
+namespace gr {
+namespace satellites {
+
+/*!
+ * \brief Max-Log-MAP decoder
+ * \ingroup satellites
+ *
+ * \details
+ * Soft-output decoder for convolutional codes using the Max-Log-MAP
+ * algorithm. It can use any constraint length and polynomials, and the
+ * codewords are assumed to be terminated with constraint - 1 zero bits,
+ * as in the Viterbi Decoder. The input PDUs can contain hard decision
+ * bits (u8vector), or soft symbols (s8vector or f32vector), where
+ * positive values mean a 1 bit.
+ *
+ * The decoded bits are output as a u8vector PDU in the out port, as in
+ * the Viterbi Decoder, and their log-likelihood ratios are output as
+ * an f32vector PDU in the llr port. The LLRs use the same convention
+ * and scale as the input symbols: a positive LLR means a 1 bit, and if
+ * the input symbols are channel LLRs, so are the output LLRs.
+ *
+ * Punctured codes are supported with a puncturing pattern as in the
+ * Viterbi Decoder.
+ */
+class SATELLITES_API max_log_map_decoder : virtual public gr::block
+{
+public:
+    typedef std::shared_ptr<max_log_map_decoder> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of satellites::max_log_map_decoder.
+     *
+     * To avoid accidental use of raw pointers, satellites::max_log_map_decoder's
+     * constructor is in a private implementation
+     * class. satellites::max_log_map_decoder::make is the public interface for
+     * creating new instances.
+     *
+     * \param constraint Constraint length of the code
+     * \param polynomials Polynomials defining the code
+     * \param puncturing Puncturing pattern (empty for no puncturing)
+     */
+    static sptr make(int constraint,
+                     const std::vector<int>& polynomials,
+                     const std::vector<int>& puncturing = std::vector<int>());
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_H */
@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_H
+#define INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_H
+
+#include <gnuradio/sync_block.h>
+#include <satellites/api.h>
+
+#include <string>
+#include <vector>
+
+namespace gr {
+namespace satellites {
+
+/*!
+ * \brief Multi Syncword Tagger
+ * \ingroup satellites
+ *
+ * \details
+ * The Multi Syncword Tagger looks for several syncwords in a stream of soft
+ * symbols, using the convention that positive values mean a 1 bit, and
+ * copies the input to the output, adding a tag whenever one of the
+ * syncwords is found. Each syncword behaves as a Correlate Access Code -
+ * Tag block: the tag is placed on the symbol that follows the syncword, and
+ * its value is the number of bit errors in the syncword.
+ *
+ * The input is sliced and packed once for all the syncwords, so this is
+ * much cheaper than using a correlator block for each syncword when several
+ * deframers process the same symbols.
+ */
+class SATELLITES_API multi_syncword_tagger : virtual public gr::sync_block
+{
+public:
+    typedef std::shared_ptr<multi_syncword_tagger> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of
+     * satellites::multi_syncword_tagger.
+     *
+     * To avoid accidental use of raw pointers, satellites::multi_syncword_tagger's
+     * constructor is in a private implementation
+     * class. satellites::multi_syncword_tagger::make is the public interface for
+     * creating new instances.
+     *
+     * \param syncwords Syncwords, as strings of '0' and '1' of up to 64 bits
+     * \param thresholds Maximum number of bit errors allowed in each syncword
+     * \param tag_names Name of the tags for each syncword
+     */
+    static sptr make(const std::vector<std::string>& syncwords,
+                     const std::vector<int>& thresholds,
+                     const std::vector<std::string>& tag_names);
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_H */
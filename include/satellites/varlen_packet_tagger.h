@@ -31,6 +31,12 @@ namespace satellites {
  * from the stream's header.  The length of the header field and
  * the endianness are parameters.
  *
+ * If packed is true, the input and output are packed bytes (MSB
+ * first), the sync tags mark the byte where the header starts, and
+ * the packet length tags give the packet size in bytes. When the
+ * length field size is not a multiple of 8, the packet starts in the
+ * middle of a byte and is realigned to byte boundaries in the output.
+ *
  */
 class SATELLITES_API varlen_packet_tagger : virtual public gr::block
 {
@@ -44,13 +50,15 @@ public:
      * \param max_packet_size
      * \param endianness
      * \param use_golay For 24-bit golay headers
+     * \param packed Use packed bytes for the input and output
      */
     static sptr make(const std::string& sync_key,
                      const std::string& packet_key,
                      int length_field_size,
                      int max_packet_size,
                      endianness_t endianness,
-                     bool use_golay);
+                     bool use_golay,
+                     bool packed = false);
 };
 
 } // namespace satellites
@@ -21,6 +21,28 @@ namespace satellites {
  * \brief Viterbi decoder
  * \ingroup satellites
  *
+ * Generic Viterbi decoder that can use any constraint length and
+ * polynomials. The input PDUs can contain hard decision bits (u8vector),
+ * or soft symbols (s8vector or f32vector), where positive values mean
+ * a 1 bit.
+ *
+ * By default the whole codeword is traced back once it has been
+ * processed. If a traceback depth is given, the decoder uses a sliding
+ * window that only stores the decisions of the last 2 * traceback_depth
+ * bits, which bounds the memory used to decode long PDUs.
+ *
+ * If a batch size larger than one is given, the PDUs that are queued
+ * in the input port are decoded together in batches of up to that
+ * size, with one PDU per SIMD lane. Only consecutive PDUs of the same
+ * length are decoded together. This increases the throughput
+ * when many PDUs arrive in bursts, such as when replaying recordings,
+ * and gives the same results as decoding the PDUs one by one.
+ *
+ * Punctured codes are supported with a puncturing pattern that lists,
+ * for each of the encoder output symbols in a puncturing period, whether
+ * the symbol is transmitted (1) or deleted (0). For instance, the CCSDS
+ * rate 2/3 and 3/4 codes use the patterns [1, 1, 0, 1] and
+ * [1, 1, 0, 1, 1, 0]. The deleted symbols are decoded as erasures.
  */
 class SATELLITES_API viterbi_decoder : virtual public gr::block
 {
@@ -34,8 +56,18 @@ public:
      * constructor is in a private implementation
      * class. satellites::viterbi_decoder::make is the public interface for
      * creating new instances.
+     *
+     * \param constraint Constraint length of the code
+     * \param polynomials Polynomials defining the code
+     * \param traceback_depth Traceback depth in bits (0 for whole codeword)
+     * \param batch_size Maximum number of PDUs decoded together
+     * \param puncturing Puncturing pattern (empty for no puncturing)
      */
-    static sptr make(int constraint, const std::vector<int>& polynomials);
+    static sptr make(int constraint,
+                     const std::vector<int>& polynomials,
+                     int traceback_depth = 0,
+                     int batch_size = 1,
+                     const std::vector<int>& puncturing = std::vector<int>());
 };
 
 } // namespace satellites
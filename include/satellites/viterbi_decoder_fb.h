@@ -0,0 +1,61 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_VITERBI_DECODER_FB_H
+#define INCLUDED_SATELLITES_VITERBI_DECODER_FB_H
+
+#include <gnuradio/sync_decimator.h>
+#include <satellites/api.h>
+
+namespace gr {
+namespace satellites {
+
+/*!
+ * \brief Streaming Viterbi decoder
+ * \ingroup satellites
+ *
+ * \details
+ * The Streaming Viterbi decoder decodes a continuous stream of soft
+ * symbols, using the convention that positive values mean a 1 bit. It
+ * can use any constraint length and polynomials. The decoded bits are
+ * output unpacked, one bit per byte.
+ *
+ * The decoder uses a sliding window with a fixed traceback depth, so
+ * the output is delayed by 2 * traceback_depth - 1 bits. The input
+ * symbols must be aligned to the boundaries of the codewords, since
+ * the block decimates by the number of polynomials. The symbols are
+ * scaled according to a running average of their amplitude over about
+ * 1000 symbols.
+ */
+class SATELLITES_API viterbi_decoder_fb : virtual public gr::sync_decimator
+{
+public:
+    typedef std::shared_ptr<viterbi_decoder_fb> sptr;
+
+    /*!
+     * \brief Return a shared_ptr to a new instance of satellites::viterbi_decoder_fb.
+     *
+     * To avoid accidental use of raw pointers, satellites::viterbi_decoder_fb's
+     * constructor is in a private implementation
+     * class. satellites::viterbi_decoder_fb::make is the public interface for
+     * creating new instances.
+     *
+     * \param constraint Constraint length of the code
+     * \param polynomials Polynomials defining the code
+     * \param traceback_depth Traceback depth in bits
+     */
+    static sptr
+    make(int constraint, const std::vector<int>& polynomials, int traceback_depth);
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_VITERBI_DECODER_FB_H */
@@ -15,6 +15,7 @@
 #include "convolutional_encoder_impl.h"
 #include <gnuradio/io_signature.h>
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -22,26 +23,45 @@ namespace gr {
 namespace satellites {
 
 convolutional_encoder::sptr
-convolutional_encoder::make(int constraint, const std::vector<int>& polynomials)
+convolutional_encoder::make(int constraint,
+                            const std::vector<int>& polynomials,
+                            const std::vector<int>& puncturing,
+                            bool packed_input,
+                            bool packed_output)
 {
-    return gnuradio::make_block_sptr<convolutional_encoder_impl>(constraint, polynomials);
+    return gnuradio::make_block_sptr<convolutional_encoder_impl>(
+        constraint, polynomials, puncturing, packed_input, packed_output);
 }
 
 /*
  * The private constructor
  */
 convolutional_encoder_impl::convolutional_encoder_impl(
-    int constraint, const std::vector<int>& polynomials)
+    int constraint,
+    const std::vector<int>& polynomials,
+    const std::vector<int>& puncturing,
+    bool packed_input,
+    bool packed_output)
     : gr::block("convolutional_encoder",
                 gr::io_signature::make(0, 0, 0),
                 gr::io_signature::make(0, 0, 0)),
-      d_codec(constraint, polynomials)
+      d_codec(make_codec(constraint, polynomials, puncturing)),
+      d_packed_input(packed_input),
+      d_packed_output(packed_output)
 {
     message_port_register_out(pmt::mp("out"));
     message_port_register_in(pmt::mp("in"));
     set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->msg_handler(msg); });
 }
 
+ViterbiCodec convolutional_encoder_impl::make_codec(int constraint,
+                                                   const std::vector<int>& polynomials,
+                                                   const std::vector<int>& puncturing)
+{
+    ViterbiCodec::CheckParameters(constraint, polynomials, 0, puncturing);
+    return ViterbiCodec(constraint, polynomials, 0, puncturing);
+}
+
 /*
  * Our virtual destructor.
  */
@@ -58,20 +78,40 @@ int convolutional_encoder_impl::general_work(int noutput_items,
 
 void convolutional_encoder_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
-    std::vector<uint8_t> msg = pmt::u8vector_elements(pmt::cdr(pmt_msg));
-    std::string bits;
-    for (auto b : msg) {
-        bits.push_back(b ? '1' : '0');
+    pmt::pmt_t msg = pmt::cdr(pmt_msg);
+    if (!pmt::is_u8vector(msg)) {
+        d_logger->error("Invalid PDU type; dropping");
+        return;
     }
+    size_t size;
+    const uint8_t* in = pmt::u8vector_elements(msg, size);
 
-    std::string outbits = d_codec.Encode(bits);
-    std::vector<uint8_t> out;
-    for (auto b : outbits) {
-        out.push_back(b == '1');
+    const uint8_t* packed = in;
+    int num_bits = 8 * size;
+    if (!d_packed_input) {
+        d_packed.assign((size + 7) / 8, 0);
+        for (size_t j = 0; j < size; ++j) {
+            d_packed[j / 8] |= (in[j] ? 1 : 0) << (7 - j % 8);
+        }
+        packed = d_packed.data();
+        num_bits = size;
     }
 
+    const int num_symbols = d_codec.EncodePacked(packed, num_bits, &d_encoded);
+
+    if (d_packed_output) {
+        message_port_pub(pmt::mp("out"),
+                         pmt::cons(pmt::car(pmt_msg),
+                                   pmt::init_u8vector(d_encoded.size(), d_encoded)));
+        return;
+    }
+
+    d_out.resize(num_symbols);
+    for (int j = 0; j < num_symbols; ++j) {
+        d_out[j] = (d_encoded[j / 8] >> (7 - j % 8)) & 1;
+    }
     message_port_pub(pmt::mp("out"),
-                     pmt::cons(pmt::car(pmt_msg), pmt::init_u8vector(out.size(), out)));
+                     pmt::cons(pmt::car(pmt_msg), pmt::init_u8vector(d_out.size(), d_out)));
 
     return;
 }
@@ -22,9 +22,22 @@ class convolutional_encoder_impl : public convolutional_encoder
 {
 private:
     ViterbiCodec d_codec;
+    const bool d_packed_input;
+    const bool d_packed_output;
+    std::vector<uint8_t> d_packed;
+    std::vector<uint8_t> d_encoded;
+    std::vector<uint8_t> d_out;
+
+    static ViterbiCodec make_codec(int constraint,
+                                   const std::vector<int>& polynomials,
+                                   const std::vector<int>& puncturing);
 
 public:
-    convolutional_encoder_impl(int constraint, const std::vector<int>& polynomials);
+    convolutional_encoder_impl(int constraint,
+                               const std::vector<int>& polynomials,
+                               const std::vector<int>& puncturing,
+                               bool packed_input,
+                               bool packed_output);
     ~convolutional_encoder_impl();
 
     int general_work(int noutput_items,
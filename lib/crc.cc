@@ -15,9 +15,194 @@
 #include <satellites/crc.h>
 #include <stdexcept>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRC_CLMUL_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN) && \
+    (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define CRC_CLMUL_PMULL
+#include <arm_neon.h>
+#endif
+
 namespace gr {
 namespace satellites {
 
+namespace {
+
+// Minimum length for which the carry-less multiplication folding is used
+constexpr std::size_t fold_min_len = 128;
+
+inline uint64_t load_le64(const uint8_t* data)
+{
+    return static_cast<uint64_t>(data[0]) | static_cast<uint64_t>(data[1]) << 8 |
+           static_cast<uint64_t>(data[2]) << 16 | static_cast<uint64_t>(data[3]) << 24 |
+           static_cast<uint64_t>(data[4]) << 32 | static_cast<uint64_t>(data[5]) << 40 |
+           static_cast<uint64_t>(data[6]) << 48 | static_cast<uint64_t>(data[7]) << 56;
+}
+
+inline uint64_t load_be64(const uint8_t* data)
+{
+    return static_cast<uint64_t>(data[0]) << 56 | static_cast<uint64_t>(data[1]) << 48 |
+           static_cast<uint64_t>(data[2]) << 40 | static_cast<uint64_t>(data[3]) << 32 |
+           static_cast<uint64_t>(data[4]) << 24 | static_cast<uint64_t>(data[5]) << 16 |
+           static_cast<uint64_t>(data[6]) << 8 | static_cast<uint64_t>(data[7]);
+}
+
+uint64_t reverse64(uint64_t word)
+{
+    uint64_t ret = 0;
+    for (int i = 0; i < 64; ++i) {
+        ret = (ret << 1) | (word & 1);
+        word >>= 1;
+    }
+    return ret;
+}
+
+// Computes x^n mod P(x), where poly is P(x) without its x^num_bits term
+uint64_t xpow_mod(unsigned n, uint64_t poly, unsigned num_bits, uint64_t mask)
+{
+    const uint64_t msb = static_cast<uint64_t>(1) << (num_bits - 1);
+    uint64_t r = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        r = ((r & msb) ? (r << 1) ^ poly : r << 1) & mask;
+    }
+    return r;
+}
+
+// The folding kernels work with 128-bit blocks of the input, seen as
+// polynomials. A block A = A_hi x^64 + A_lo is moved forward by n bits as
+// A_hi (x^(n + 64) mod P) + A_lo (x^n mod P), which fits in 128 bits for
+// CRCs of up to 64 bits. Four blocks are folded in parallel, and then
+// combined into one block that gives the same CRC register as the input.
+//
+// For reflected CRCs the bit order of the blocks is reversed, so the
+// constants are reversed too. Since the carry-less product of two reversed
+// 64-bit words is the reversed product shifted by one bit, the constants
+// are x^(n - 1) mod P instead of x^n mod P.
+//
+// The fold array contains the constants that multiply the low and high
+// 64-bit words of a block when folding by 512 and by 128 bits.
+
+#ifdef CRC_CLMUL_X86
+__attribute__((target("pclmul,ssse3"))) inline __m128i
+fold_x86(__m128i x, __m128i k, __m128i next)
+{
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                                       _mm_clmulepi64_si128(x, k, 0x11)),
+                         next);
+}
+
+__attribute__((target("pclmul,ssse3"))) void fold_clmul(const uint8_t* data,
+                                                        std::size_t len,
+                                                        uint64_t rem,
+                                                        const uint64_t* fold,
+                                                        bool reflected,
+                                                        uint8_t* out)
+{
+    // Non-reflected blocks are byte-reversed so that the first byte holds
+    // the highest degree coefficients
+    const __m128i order =
+        reflected ? _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+                  : _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m128i k512 = _mm_set_epi64x(fold[1], fold[0]);
+    const __m128i k128 = _mm_set_epi64x(fold[3], fold[2]);
+    const uint8_t* end = data + len;
+    __m128i x[4];
+
+    for (int j = 0; j < 4; ++j) {
+        x[j] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&data[16 * j]), order);
+    }
+    // The CRC register is added to the first bytes of the input
+    x[0] = _mm_xor_si128(x[0],
+                         reflected ? _mm_set_epi64x(0, rem) : _mm_set_epi64x(rem, 0));
+    for (data += 64; end - data >= 64; data += 64) {
+        for (int j = 0; j < 4; ++j) {
+            x[j] = fold_x86(
+                x[j],
+                k512,
+                _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&data[16 * j]), order));
+        }
+    }
+    __m128i acc = x[0];
+    for (int j = 1; j < 4; ++j) {
+        acc = fold_x86(acc, k128, x[j]);
+    }
+    for (; data < end; data += 16) {
+        acc = fold_x86(
+            acc, k128, _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), order));
+    }
+    _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(acc, order));
+}
+
+bool have_clmul()
+{
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+}
+#endif
+
+#ifdef CRC_CLMUL_PMULL
+inline uint8x16_t fold_pmull(uint8x16_t x, uint64x2_t k, uint8x16_t next)
+{
+    const poly64x2_t x64 = vreinterpretq_p64_u8(x);
+    const poly64x2_t k64 = vreinterpretq_p64_u64(k);
+    const poly128_t lo = vmull_p64(vgetq_lane_p64(x64, 0), vgetq_lane_p64(k64, 0));
+    const poly128_t hi = vmull_high_p64(x64, k64);
+    return veorq_u8(veorq_u8(vreinterpretq_u8_p128(lo), vreinterpretq_u8_p128(hi)),
+                    next);
+}
+
+// Same as the x86 version
+void fold_clmul(const uint8_t* data,
+                std::size_t len,
+                uint64_t rem,
+                const uint64_t* fold,
+                bool reflected,
+                uint8_t* out)
+{
+    const auto load = [reflected](const uint8_t* p) {
+        const uint8x16_t v = vld1q_u8(p);
+        if (reflected) {
+            return v;
+        }
+        const uint8x16_t r = vrev64q_u8(v);
+        return vextq_u8(r, r, 8);
+    };
+    const uint64x2_t k512 = vcombine_u64(vcreate_u64(fold[0]), vcreate_u64(fold[1]));
+    const uint64x2_t k128 = vcombine_u64(vcreate_u64(fold[2]), vcreate_u64(fold[3]));
+    const uint8_t* end = data + len;
+    uint8x16_t x[4];
+
+    for (int j = 0; j < 4; ++j) {
+        x[j] = load(&data[16 * j]);
+    }
+    const uint64x2_t r = reflected ? vcombine_u64(vcreate_u64(rem), vcreate_u64(0))
+                                   : vcombine_u64(vcreate_u64(0), vcreate_u64(rem));
+    x[0] = veorq_u8(x[0], vreinterpretq_u8_u64(r));
+    for (data += 64; end - data >= 64; data += 64) {
+        for (int j = 0; j < 4; ++j) {
+            x[j] = fold_pmull(x[j], k512, load(&data[16 * j]));
+        }
+    }
+    uint8x16_t acc = x[0];
+    for (int j = 1; j < 4; ++j) {
+        acc = fold_pmull(acc, k128, x[j]);
+    }
+    for (; data < end; data += 16) {
+        acc = fold_pmull(acc, k128, load(data));
+    }
+    if (!reflected) {
+        acc = vrev64q_u8(acc);
+        acc = vextq_u8(acc, acc, 8);
+    }
+    vst1q_u8(out, acc);
+}
+
+bool have_clmul() { return true; }
+#endif
+} // namespace
+
 crc::crc(unsigned num_bits,
          uint64_t poly,
          uint64_t initial_value,
@@ -35,8 +220,21 @@ crc::crc(unsigned num_bits,
     if ((num_bits < 8) || (num_bits > 64)) {
         throw std::runtime_error("CRC number of bits must be between 8 and 64");
     }
+    d_poly = poly & d_mask;
 
-    d_table[0] = 0;
+    // In reflected CRCs the low word of a block holds the highest degree
+    // coefficients
+    const unsigned fold_bits[2][4] = { { 512, 576, 128, 192 }, { 575, 511, 191, 127 } };
+    for (int j = 0; j < 4; ++j) {
+        if (d_input_reflected) {
+            d_fold[j] = reverse64(xpow_mod(fold_bits[1][j], poly, num_bits, d_mask));
+        } else {
+            d_fold[j] = xpow_mod(fold_bits[0][j], poly, num_bits, d_mask);
+        }
+    }
+
+    auto& table = d_tables[0];
+    table[0] = 0;
     if (d_input_reflected) {
         poly = reflect(poly);
         uint64_t crc = 1;
@@ -48,7 +246,7 @@ crc::crc(unsigned num_bits,
                 crc >>= 1;
             }
             for (int j = 0; j < 256; j += 2 * i) {
-                d_table[i + j] = (crc ^ d_table[j]) & d_mask;
+                table[i + j] = (crc ^ table[j]) & d_mask;
             }
             i >>= 1;
         } while (i > 0);
@@ -63,42 +261,156 @@ crc::crc(unsigned num_bits,
                 crc <<= 1;
             }
             for (int j = 0; j < i; ++j) {
-                d_table[i + j] = (crc ^ d_table[j]) & d_mask;
+                table[i + j] = (crc ^ table[j]) & d_mask;
             }
             i <<= 1;
         } while (i < 256);
     }
+
+    // The tables for the bytes followed by zeros are obtained by running
+    // the CRC register one more byte
+    if (d_input_reflected) {
+        for (size_t n = 1; n < d_tables.size(); ++n) {
+            for (int b = 0; b < 256; ++b) {
+                const uint64_t prev = d_tables[n - 1][b];
+                d_tables[n][b] = table[prev & 0xff] ^ (prev >> 8);
+            }
+        }
+    } else {
+        const unsigned shift = 64 - d_num_bits;
+        for (auto& entry : table) {
+            entry <<= shift;
+        }
+        for (size_t n = 1; n < d_tables.size(); ++n) {
+            for (int b = 0; b < 256; ++b) {
+                const uint64_t prev = d_tables[n - 1][b];
+                d_tables[n][b] = table[prev >> 56] ^ (prev << 8);
+            }
+        }
+    }
 }
 
 crc::~crc() {}
 
-uint64_t crc::compute(const uint8_t* data, std::size_t len)
+uint64_t crc::compute(const uint8_t* data, std::size_t len) const
+{
+    return finalize(update(init(), data, len));
+}
+
+uint64_t crc::init() const
+{
+    return d_input_reflected ? d_initial_value : d_initial_value << (64 - d_num_bits);
+}
+
+uint64_t crc::finalize(uint64_t state) const
+{
+    uint64_t rem = d_input_reflected ? state : state >> (64 - d_num_bits);
+
+    if (d_input_reflected != d_result_reflected) {
+        rem = reflect(rem);
+    }
+
+    rem = rem ^ d_final_xor;
+    return rem;
+}
+
+uint64_t crc::combine(uint64_t crc_a, uint64_t crc_b, std::size_t len_b) const
+{
+    // The register after A and B is the register after B starting from zero
+    // plus the register after A moved forward by the length of B. The
+    // register after B starting from the initial value already contains the
+    // initial value moved forward by the length of B, so it is subtracted.
+    const uint64_t initial =
+        d_input_reflected ? reflect(d_initial_value) : d_initial_value;
+    const uint64_t a = crc_to_poly(crc_a) ^ initial;
+    return poly_to_crc(crc_to_poly(crc_b) ^ mul_mod(a, xpow8n_mod(len_b)));
+}
+
+uint64_t crc::update(uint64_t rem, const uint8_t* data, std::size_t len) const
+{
+#if defined(CRC_CLMUL_X86) || defined(CRC_CLMUL_PMULL)
+    if (len >= fold_min_len && have_clmul()) {
+        // The input is folded into 16 bytes that give the same CRC register
+        // starting from zero, and the remaining bytes are processed with
+        // the tables
+        uint8_t folded[16];
+        const std::size_t fold_len = len & ~static_cast<std::size_t>(15);
+        fold_clmul(data, fold_len, rem, d_fold.data(), d_input_reflected, folded);
+        rem = update_tables(0, folded, sizeof(folded));
+        data += fold_len;
+        len -= fold_len;
+    }
+#endif
+    return update_tables(rem, data, len);
+}
+
+uint64_t crc::update_tables(uint64_t rem, const uint8_t* data, std::size_t len) const
 {
-    uint64_t rem = d_initial_value;
+    const auto& t = d_tables;
 
     if (d_input_reflected) {
-        for (std::size_t i = 0; i < len; ++i) {
-            uint8_t byte = data[i];
-            uint8_t idx = (rem ^ byte) & 0xff;
-            rem = d_table[idx] ^ (rem >> 8);
+        for (; len >= 8; len -= 8, data += 8) {
+            const uint64_t x = rem ^ load_le64(data);
+            rem = t[7][x & 0xff] ^ t[6][(x >> 8) & 0xff] ^ t[5][(x >> 16) & 0xff] ^
+                  t[4][(x >> 24) & 0xff] ^ t[3][(x >> 32) & 0xff] ^
+                  t[2][(x >> 40) & 0xff] ^ t[1][(x >> 48) & 0xff] ^ t[0][x >> 56];
+        }
+        for (; len > 0; --len, ++data) {
+            rem = t[0][(rem ^ *data) & 0xff] ^ (rem >> 8);
         }
     } else {
-        for (std::size_t i = 0; i < len; ++i) {
-            uint8_t byte = data[i];
-            uint8_t idx = ((rem >> (d_num_bits - 8)) ^ byte) & 0xff;
-            rem = (d_table[idx] ^ (rem << 8)) & d_mask;
+        for (; len >= 8; len -= 8, data += 8) {
+            const uint64_t x = rem ^ load_be64(data);
+            rem = t[7][x >> 56] ^ t[6][(x >> 48) & 0xff] ^ t[5][(x >> 40) & 0xff] ^
+                  t[4][(x >> 32) & 0xff] ^ t[3][(x >> 24) & 0xff] ^
+                  t[2][(x >> 16) & 0xff] ^ t[1][(x >> 8) & 0xff] ^ t[0][x & 0xff];
+        }
+        for (; len > 0; --len, ++data) {
+            rem = t[0][(rem >> 56) ^ *data] ^ (rem << 8);
         }
     }
 
-    if (d_input_reflected != d_result_reflected) {
-        rem = reflect(rem);
+    return rem;
+}
+
+uint64_t crc::mul_mod(uint64_t a, uint64_t b) const
+{
+    const uint64_t msb = static_cast<uint64_t>(1) << (d_num_bits - 1);
+    uint64_t r = 0;
+    for (int i = d_num_bits - 1; i >= 0; --i) {
+        r = ((r & msb) ? (r << 1) ^ d_poly : r << 1) & d_mask;
+        if ((b >> i) & 1) {
+            r ^= a;
+        }
     }
+    return r;
+}
 
-    rem = rem ^ d_final_xor;
-    return rem;
+uint64_t crc::xpow8n_mod(std::size_t n) const
+{
+    uint64_t r = 1;
+    uint64_t x8 = xpow_mod(8, d_poly, d_num_bits, d_mask);
+    for (; n > 0; n >>= 1) {
+        if (n & 1) {
+            r = mul_mod(r, x8);
+        }
+        x8 = mul_mod(x8, x8);
+    }
+    return r;
+}
+
+uint64_t crc::crc_to_poly(uint64_t crc) const
+{
+    crc = (crc ^ d_final_xor) & d_mask;
+    return d_result_reflected ? reflect(crc) : crc;
+}
+
+uint64_t crc::poly_to_crc(uint64_t poly) const
+{
+    return (d_result_reflected ? reflect(poly) : poly) ^ d_final_xor;
 }
 
-uint64_t crc::reflect(uint64_t word)
+uint64_t crc::reflect(uint64_t word) const
 {
     uint64_t ret;
     ret = word & 1;
@@ -12,6 +12,7 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -29,7 +30,9 @@ crc_check::sptr crc_check::make(unsigned num_bits,
                                 bool result_reflected,
                                 bool swap_endianness,
                                 bool discard_crc,
-                                unsigned skip_header_bytes)
+                                unsigned skip_header_bytes,
+                                unsigned max_bit_errors,
+                                unsigned max_frame_len)
 {
     return gnuradio::make_block_sptr<crc_check_impl>(num_bits,
                                                      poly,
@@ -39,7 +42,9 @@ crc_check::sptr crc_check::make(unsigned num_bits,
                                                      result_reflected,
                                                      swap_endianness,
                                                      discard_crc,
-                                                     skip_header_bytes);
+                                                     skip_header_bytes,
+                                                     max_bit_errors,
+                                                     max_frame_len);
 }
 
 crc_check_impl::crc_check_impl(unsigned num_bits,
@@ -50,7 +55,9 @@ crc_check_impl::crc_check_impl(unsigned num_bits,
                                bool result_reflected,
                                bool swap_endianness,
                                bool discard_crc,
-                               unsigned skip_header_bytes)
+                               unsigned skip_header_bytes,
+                               unsigned max_bit_errors,
+                               unsigned max_frame_len)
     : gr::block(
           "crc_check", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)),
       d_num_bits(num_bits),
@@ -58,11 +65,18 @@ crc_check_impl::crc_check_impl(unsigned num_bits,
       d_discard_crc(discard_crc),
       d_crc(crc(
           num_bits, poly, initial_value, final_xor, input_reflected, result_reflected)),
-      d_header_bytes(skip_header_bytes)
+      d_header_bytes(skip_header_bytes),
+      d_max_bit_errors(max_bit_errors)
 {
     if (num_bits % 8 != 0) {
         throw std::runtime_error("CRC number of bits must be divisible by 8");
     }
+    if (max_bit_errors > 2) {
+        throw std::runtime_error("CRC check can correct at most 2 bit errors");
+    }
+    if (max_bit_errors > 0) {
+        init_syndrome_table(max_frame_len);
+    }
     message_port_register_out(pmt::mp("ok"));
     message_port_register_out(pmt::mp("fail"));
     message_port_register_in(pmt::mp("in"));
@@ -71,6 +85,112 @@ crc_check_impl::crc_check_impl(unsigned num_bits,
 
 crc_check_impl::~crc_check_impl() {}
 
+void crc_check_impl::init_syndrome_table(unsigned max_frame_len)
+{
+    const unsigned num_bytes = d_num_bits / 8;
+    const size_t frame_bits = 8 * static_cast<size_t>(max_frame_len);
+    d_bit_syndromes.assign(frame_bits, 0);
+
+    // Errors in the CRC flip the received CRC bits
+    for (unsigned q = 0; q < std::min(d_num_bits, static_cast<unsigned>(frame_bits));
+         ++q) {
+        const unsigned byte = q / 8;
+        const unsigned shift = d_swap_endianness ? 8 * (num_bytes - 1 - byte) : 8 * byte;
+        d_bit_syndromes[q] = static_cast<uint64_t>(1) << (shift + q % 8);
+    }
+
+    // Errors in the data change the computed CRC by the CRC of the error
+    // pattern without the initial value and final XOR. The contribution of
+    // an error followed by k zero bytes is obtained by running the CRC
+    // register k bytes from the register of the error alone.
+    const uint64_t zero_crc = d_crc.finalize(0);
+    const uint8_t zero = 0;
+    for (unsigned bit = 0; bit < 8; ++bit) {
+        const uint8_t error = 1U << bit;
+        uint64_t state = d_crc.update(0, &error, 1);
+        for (size_t q = 8 * num_bytes + bit; q < frame_bits; q += 8) {
+            d_bit_syndromes[q] = d_crc.finalize(state) ^ zero_crc;
+            state = d_crc.update(state, &zero, 1);
+        }
+    }
+
+    d_syndrome_positions.reserve(frame_bits);
+    for (uint32_t q = 0; q < frame_bits; ++q) {
+        const uint64_t syndrome = d_bit_syndromes[q];
+        if (syndrome == 0) {
+            continue;
+        }
+        auto it = d_syndrome_positions.find(syndrome);
+        if (it == d_syndrome_positions.end()) {
+            d_syndrome_positions[syndrome] = { q, d_no_position };
+        } else if (it->second.second == d_no_position) {
+            it->second.second = q;
+        }
+    }
+}
+
+int crc_check_impl::find_bit_error(uint64_t syndrome,
+                                   size_t frame_bits,
+                                   uint32_t* q) const
+{
+    const auto it = d_syndrome_positions.find(syndrome);
+    if (it == d_syndrome_positions.end() || it->second.first >= frame_bits) {
+        return 0;
+    }
+    *q = it->second.first;
+    return it->second.second < frame_bits ? 2 : 1;
+}
+
+bool crc_check_impl::find_errors(uint64_t syndrome,
+                                 size_t frame_bits,
+                                 std::vector<uint32_t>& q) const
+{
+    q.clear();
+    if (frame_bits > d_bit_syndromes.size()) {
+        return false;
+    }
+
+    uint32_t q1, q2;
+    const int single = find_bit_error(syndrome, frame_bits, &q1);
+    if (single > 1) {
+        return false;
+    }
+    if (single == 1) {
+        q.push_back(q1);
+    }
+    if (d_max_bit_errors < 2) {
+        return !q.empty();
+    }
+
+    // For each candidate position of the first error, the second error is
+    // the one that gives the remaining syndrome. A pair of errors with the
+    // same syndrome as a single error or as another pair (which can happen
+    // with CRCs of Hamming distance 3 or 4) makes the correction ambiguous.
+    for (q1 = 0; q1 < frame_bits; ++q1) {
+        const int second = find_bit_error(syndrome ^ d_bit_syndromes[q1], frame_bits, &q2);
+        if (second == 0) {
+            continue;
+        }
+        // Two positions for the remaining syndrome give two different
+        // pairs with q1. This must be checked before skipping the pairs
+        // that were already seen, since one of them can have q2 < q1.
+        if (second > 1) {
+            q.clear();
+            return false;
+        }
+        if (q2 <= q1) {
+            continue;
+        }
+        if (!q.empty()) {
+            q.clear();
+            return false;
+        }
+        q.push_back(q1);
+        q.push_back(q2);
+    }
+    return !q.empty();
+}
+
 void crc_check_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required) {}
 
 int crc_check_impl::general_work(int noutput_items,
@@ -109,16 +229,33 @@ void crc_check_impl::msg_handler(pmt::pmt_t pmt_msg)
     const uint64_t crc_computed =
         d_crc.compute(&msg[d_header_bytes], size - d_header_bytes - num_bytes);
 
-    const bool crc_ok = crc_computed == msg_crc;
+    bool crc_ok = crc_computed == msg_crc;
+    auto meta = pmt::car(pmt_msg);
+    std::vector<uint32_t> errors;
     if (crc_ok) {
         this->d_logger->info("CRC OK");
+    } else if (d_max_bit_errors > 0 &&
+               find_errors(crc_computed ^ msg_crc, 8 * (size - d_header_bytes), errors)) {
+        std::vector<int32_t> positions;
+        for (const auto q : errors) {
+            const auto byte = size - 1 - q / 8;
+            msg[byte] ^= 1U << (q % 8);
+            positions.push_back(8 * byte + 7 - q % 8);
+        }
+        crc_ok = true;
+        this->d_logger->info("CRC OK (corrected {:d} bits)", errors.size());
+        meta = pmt::dict_add(
+            meta, pmt::mp("crc_corrected_bits"), pmt::from_long(errors.size()));
+        meta = pmt::dict_add(meta,
+                             pmt::mp("crc_corrected_positions"),
+                             pmt::init_s32vector(positions.size(), positions));
     } else {
         this->d_logger->info("CRC fail");
     }
 
     const auto out_size = d_discard_crc ? size - num_bytes : size;
     message_port_pub(crc_ok ? pmt::mp("ok") : pmt::mp("fail"),
-                     pmt::cons(pmt::car(pmt_msg), pmt::init_u8vector(out_size, msg)));
+                     pmt::cons(meta, pmt::init_u8vector(out_size, msg)));
 }
 
 } /* namespace satellites */
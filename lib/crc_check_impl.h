@@ -14,6 +14,10 @@
 #include <satellites/crc.h>
 #include <satellites/crc_check.h>
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 namespace gr {
 namespace satellites {
 
@@ -25,6 +29,32 @@ private:
     bool d_discard_crc;
     crc d_crc;
     unsigned d_header_bytes;
+    unsigned d_max_bit_errors;
+
+    // Bit error correction. Bit errors are identified by their position q
+    // counting from the last bit of the PDU, so that their syndrome
+    // (computed CRC XOR received CRC) does not depend on the PDU length.
+    // d_bit_syndromes[q] is the syndrome of an error in bit q, and
+    // d_syndrome_positions maps each syndrome to the two lowest positions
+    // that have it (the second is d_no_position if there is only one).
+    struct positions {
+        uint32_t first;
+        uint32_t second;
+    };
+    constexpr static uint32_t d_no_position = UINT32_MAX;
+    std::vector<uint64_t> d_bit_syndromes;
+    std::unordered_map<uint64_t, positions> d_syndrome_positions;
+
+    void init_syndrome_table(unsigned max_frame_len);
+
+    // Looks up the position of a single bit error with the given syndrome in
+    // a frame of frame_bits bits. Returns the number of positions found,
+    // which is 2 if the error is ambiguous.
+    int find_bit_error(uint64_t syndrome, size_t frame_bits, uint32_t* q) const;
+
+    // Finds a unique pattern of up to d_max_bit_errors bit errors with the
+    // given syndrome. Returns false if there is none.
+    bool find_errors(uint64_t syndrome, size_t frame_bits, std::vector<uint32_t>& q) const;
 
 public:
     crc_check_impl(unsigned num_bits,
@@ -35,7 +65,9 @@ public:
                    bool result_reflected,
                    bool swap_endianness,
                    bool discard_crc,
-                   unsigned skip_header_bytes);
+                   unsigned skip_header_bytes,
+                   unsigned max_bit_errors,
+                   unsigned max_frame_len);
     ~crc_check_impl();
 
     // Where all the action really happens
@@ -17,6 +17,7 @@
 #include "decode_ra_code_impl.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/logger.h>
+#include <volk/volk.h>
 
 extern "C" {
 #include "radecoder/ra_decoder_gen.h"
@@ -68,8 +69,19 @@ int decode_ra_code_impl::general_work(int noutput_items,
 
 void decode_ra_code_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
+    const auto msg = pmt::cdr(pmt_msg);
     size_t length(0);
-    auto soft_bits = pmt::f32vector_elements(pmt::cdr(pmt_msg), length);
+    const float* soft_bits;
+    if (pmt::is_s8vector(msg)) {
+        // Soft bits quantized to int8. The decoder uses min-sum, so the
+        // scale of the soft bits does not matter.
+        auto soft_bits_s8 = pmt::s8vector_elements(msg, length);
+        d_soft_bits.resize(length);
+        volk_8i_s32f_convert_32f(d_soft_bits.data(), soft_bits_s8, 1.0f, length);
+        soft_bits = d_soft_bits.data();
+    } else {
+        soft_bits = pmt::f32vector_elements(msg, length);
+    }
 
     ra_length_init(d_ra_context.get(), d_size / 2);
     const auto ra_code_length = d_ra_context->ra_code_length;
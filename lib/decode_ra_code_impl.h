@@ -29,6 +29,7 @@ private:
     constexpr static float d_error_threshold = 0.35f;
     int d_size;
     std::unique_ptr<struct ra_context> d_ra_context;
+    std::vector<float> d_soft_bits;
     std::vector<float> d_ra_in;
     std::vector<uint8_t> d_ra_out;
     std::vector<ra_word_t> d_ra_recode;
@@ -13,13 +13,16 @@
 #endif
 
 #include "decode_rs_impl.h"
+#include "rs_cache.h"
 #include <gnuradio/io_signature.h>
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
 
 extern "C" {
 #include "libfec/fec.h"
+#include "libfec/rs_simd.h"
 }
 
 namespace gr {
@@ -46,14 +49,22 @@ decode_rs_impl::decode_rs_impl(bool dual_basis, int interleave)
       d_interleave(interleave)
 {
     if (dual_basis) {
-        d_decode_rs = [](uint8_t* data) { return decode_rs_ccsds(data, NULL, 0, 0); };
+        d_decode_rs = [](uint8_t* data, int* eras_pos, int no_eras) {
+            return decode_rs_ccsds(data, eras_pos, no_eras, 0);
+        };
     } else {
-        d_decode_rs = [](uint8_t* data) { return decode_rs_8(data, NULL, 0, 0); };
+        d_decode_rs = [](uint8_t* data, int* eras_pos, int no_eras) {
+            return decode_rs_8(data, eras_pos, no_eras, 0);
+        };
     }
     d_rs_codeword.resize(d_ccsds_nn);
+    d_symsize = 8;
     d_nroots = d_ccsds_nroots;
+    d_simd = rs_simd_ccsds();
+    d_dual_basis = dual_basis;
 
     check_interleave();
+    init_syndromes();
     set_message_ports();
 }
 
@@ -66,16 +77,21 @@ decode_rs_impl::decode_rs_impl(
           "decode_rs", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)),
       d_interleave(interleave)
 {
-    d_rs_p = init_rs_char(symsize, gfpoly, fcr, prim, nroots, 0);
+    d_rs_p = get_rs_char(symsize, gfpoly, fcr, prim, nroots);
     if (!d_rs_p) {
         throw std::runtime_error("Unable to initialize Reed-Solomon definition");
     }
-    d_decode_rs = [this](uint8_t* data) { return decode_rs_char(d_rs_p, data, 0, 0); };
+    d_decode_rs = [this](uint8_t* data, int* eras_pos, int no_eras) {
+        return decode_rs_char(d_rs_p.get(), data, eras_pos, no_eras);
+    };
 
     d_rs_codeword.resize((1U << symsize) - 1);
+    d_symsize = symsize;
     d_nroots = nroots;
+    d_simd = rs_simd_char(d_rs_p.get());
 
     check_interleave();
+    init_syndromes();
     set_message_ports();
 }
 
@@ -87,6 +103,23 @@ void decode_rs_impl::check_interleave()
     }
 }
 
+void decode_rs_impl::init_syndromes()
+{
+    if (d_interleave > RS_SIMD_MAX_INTERLEAVE) {
+        d_simd = NULL;
+        return;
+    }
+    d_syndrome_tab.resize(32 * d_nroots);
+    // Dual basis data is handled by the syndrome tables, so that the
+    // syndromes are computed directly from the PDU
+    rs_simd_interleaved_tables(d_simd,
+                               d_interleave,
+                               d_dual_basis ? Tal1tab : NULL,
+                               d_dual_basis ? Taltab : NULL,
+                               d_syndrome_tab.data());
+    d_syndromes.resize(d_interleave * d_nroots);
+}
+
 void decode_rs_impl::set_message_ports()
 {
     message_port_register_out(pmt::mp("out"));
@@ -97,12 +130,7 @@ void decode_rs_impl::set_message_ports()
 /*
  * Our virtual destructor.
  */
-decode_rs_impl::~decode_rs_impl()
-{
-    if (d_rs_p) {
-        free_rs_char(d_rs_p);
-    }
-}
+decode_rs_impl::~decode_rs_impl() {}
 
 void decode_rs_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required) {}
 
@@ -114,10 +142,128 @@ int decode_rs_impl::general_work(int noutput_items,
     return 0;
 }
 
+bool decode_rs_impl::get_symbols(pmt::pmt_t pmt_msg)
+{
+    const auto data = pmt::cdr(pmt_msg);
+    d_reliability.clear();
+
+    if (pmt::is_u8vector(data)) {
+        d_msg = pmt::u8vector_elements(data);
+        const auto reliability =
+            pmt::dict_ref(pmt::car(pmt_msg), pmt::mp("rs_reliability"), pmt::PMT_NIL);
+        if (pmt::is_f32vector(reliability)) {
+            d_reliability = pmt::f32vector_elements(reliability);
+            if (d_reliability.size() != d_msg.size()) {
+                d_logger->error("rs_reliability size does not match message size. "
+                                "size = {:d}, rs_reliability size = {:d}",
+                                d_msg.size(),
+                                d_reliability.size());
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (pmt::is_f32vector(data)) {
+        // Soft bits, packed MSB first into symbols. The reliability of a
+        // symbol is the reliability of its least reliable bit.
+        size_t size;
+        const float* soft = pmt::f32vector_elements(data, size);
+        if (size % d_symsize != 0) {
+            d_logger->error("Soft message size not divisible by symbol size. "
+                            "size = {:d}, symbol size = {:d}",
+                            size,
+                            d_symsize);
+            return false;
+        }
+        d_msg.resize(size / d_symsize);
+        d_reliability.resize(size / d_symsize);
+        for (size_t j = 0; j < d_msg.size(); ++j) {
+            uint8_t symbol = 0;
+            float reliability = std::abs(soft[0]);
+            for (int k = 0; k < d_symsize; ++k, ++soft) {
+                symbol = (symbol << 1) | (*soft > 0.0f);
+                reliability = std::min(reliability, std::abs(*soft));
+            }
+            d_msg[j] = symbol;
+            d_reliability[j] = reliability;
+        }
+        return true;
+    }
+
+    d_logger->error("Invalid PDU type; dropping");
+    return false;
+}
+
+int decode_rs_impl::decode_codeword(int rs_nn, int pad, int path, int* erasures)
+{
+    *erasures = 0;
+    if (d_reliability.empty()) {
+        return d_decode_rs(d_rs_codeword.data(), NULL, 0);
+    }
+
+    d_received = d_rs_codeword;
+    auto rs_res = d_decode_rs(d_rs_codeword.data(), NULL, 0);
+    if (rs_res >= 0) {
+        return rs_res;
+    }
+
+    // Find the nroots least reliable symbols, sorted by reliability
+    d_order.resize(rs_nn);
+    for (int k = 0; k < rs_nn; ++k) {
+        d_order[k] = k;
+    }
+    const int max_erasures = std::min(d_nroots, rs_nn);
+    std::partial_sort(
+        d_order.begin(),
+        d_order.begin() + max_erasures,
+        d_order.end(),
+        [this, path](int a, int b) {
+            return d_reliability[path + a * d_interleave] <
+                   d_reliability[path + b * d_interleave];
+        });
+
+    // Each pair of erasures reduces the number of errors that can be corrected
+    // by one, so the number of erasures is increased in steps of two.
+    d_eras_pos.resize(d_nroots);
+    for (int no_eras = 2; no_eras <= max_erasures; no_eras += 2) {
+        for (int k = 0; k < no_eras; ++k) {
+            d_eras_pos[k] = pad + d_order[k];
+        }
+        std::copy(d_received.begin(), d_received.end(), d_rs_codeword.begin());
+        rs_res = d_decode_rs(d_rs_codeword.data(), d_eras_pos.data(), no_eras);
+        if (rs_res >= 0) {
+            d_logger->debug("Reed-Solomon decode succeeded with {:d} erasures "
+                            "(interleaver path {:d})",
+                            no_eras,
+                            path);
+            *erasures = no_eras;
+            return rs_res;
+        }
+    }
+
+    return -1;
+}
+
+unsigned decode_rs_impl::paths_with_errors(int rs_nn)
+{
+    return rs_simd_syndromes_interleaved(d_simd,
+                                         d_syndrome_tab.data(),
+                                         d_dual_basis ? Tal1tab : NULL,
+                                         d_msg.data(),
+                                         rs_nn,
+                                         d_interleave,
+                                         d_syndromes.data());
+}
+
 void decode_rs_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
-    auto msg = pmt::u8vector_elements(pmt::cdr(pmt_msg));
+    if (!get_symbols(pmt_msg)) {
+        return;
+    }
+    const auto& msg = d_msg;
     int errors = 0;
+    int erasures = 0;
 
     if (msg.size() % d_interleave != 0) {
         d_logger->warn("Reed-Solomon message size not divisible by interleave "
@@ -141,13 +287,23 @@ void decode_rs_impl::msg_handler(pmt::pmt_t pmt_msg)
     d_output_frame.resize(msg.size() - d_interleave * d_nroots);
     const auto pad = d_rs_codeword.size() - rs_nn;
 
+    // The codewords without errors are copied directly to the output, and
+    // only those with errors go through the decoder.
+    const unsigned with_errors = d_simd ? paths_with_errors(rs_nn) : 0;
+    std::copy(msg.begin(), msg.begin() + d_output_frame.size(), d_output_frame.begin());
+
     for (int j = 0; j < d_interleave; ++j) {
+        if (d_simd && !(with_errors & (1U << j))) {
+            continue;
+        }
+
         std::fill(d_rs_codeword.begin(), d_rs_codeword.begin() + pad, 0);
         for (int k = 0; k < rs_nn; ++k) {
             d_rs_codeword[pad + k] = msg[j + k * d_interleave];
         }
 
-        auto rs_res = d_decode_rs(d_rs_codeword.data());
+        int path_erasures;
+        auto rs_res = decode_codeword(rs_nn, pad, j, &path_erasures);
         if (rs_res < 0) {
             d_logger->debug("Reed-Solomon decode fail (interleaver path {:d})", j);
             return;
@@ -157,6 +313,7 @@ void decode_rs_impl::msg_handler(pmt::pmt_t pmt_msg)
             rs_res,
             j);
         errors += rs_res;
+        erasures += path_erasures;
 
         for (int k = 0; k < rs_nn - d_nroots; ++k) {
             d_output_frame[j + k * d_interleave] = d_rs_codeword[pad + k];
@@ -165,6 +322,9 @@ void decode_rs_impl::msg_handler(pmt::pmt_t pmt_msg)
 
     auto meta =
         pmt::dict_add(pmt::car(pmt_msg), pmt::mp("rs_errors"), pmt::from_long(errors));
+    if (!d_reliability.empty()) {
+        meta = pmt::dict_add(meta, pmt::mp("rs_erasures"), pmt::from_long(erasures));
+    }
 
     message_port_pub(
         pmt::mp("out"),
@@ -15,8 +15,11 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
+struct rs_simd;
+
 namespace gr {
 namespace satellites {
 
@@ -26,16 +29,51 @@ private:
     int d_interleave;
     std::vector<uint8_t> d_rs_codeword;
     std::vector<uint8_t> d_output_frame;
+    int d_symsize;
     int d_nroots;
-    void* d_rs_p = NULL;
+    std::shared_ptr<void> d_rs_p;
+
+    // Arguments: codeword, erasure positions, number of erasures
+    std::function<int(uint8_t*, int*, int)> d_decode_rs;
+
+    // Received symbols and their reliabilities (empty if not available)
+    std::vector<uint8_t> d_msg;
+    std::vector<float> d_reliability;
+    // Buffers for errors-and-erasures decoding
+    std::vector<uint8_t> d_received;
+    std::vector<int> d_order;
+    std::vector<int> d_eras_pos;
 
-    std::function<int(uint8_t*)> d_decode_rs;
+    // Syndrome check of all the interleaved codewords at once, which is used
+    // to skip the decoding of the codewords without errors. d_simd is NULL
+    // if the interleave depth is not supported.
+    const struct rs_simd* d_simd = NULL;
+    bool d_dual_basis = false;
+    std::vector<uint8_t> d_syndrome_tab;
+    std::vector<uint8_t> d_syndromes;
 
     constexpr static int d_ccsds_nn = 255;
     constexpr static int d_ccsds_nroots = 32;
 
     void check_interleave();
     void set_message_ports();
+    void init_syndromes();
+
+    // Returns a mask with bit j set if the codeword of interleaver path j in
+    // d_msg has errors. It can only be used if d_simd is not NULL.
+    unsigned paths_with_errors(int rs_nn);
+
+    // Reads the PDU into d_msg and d_reliability. Returns false if the PDU
+    // is invalid.
+    bool get_symbols(pmt::pmt_t pmt_msg);
+
+    // Decodes the codeword in d_rs_codeword, which has rs_nn symbols after
+    // pad zeros, and which comes from interleaver path path. If plain
+    // decoding fails and reliabilities are available, the least reliable
+    // symbols are erased and decoding is retried. Returns the number of
+    // corrected symbols, or -1 if decoding fails. The number of erasures
+    // used is written to erasures.
+    int decode_codeword(int rs_nn, int pad, int path, int* erasures);
 
 public:
     decode_rs_impl(bool dual_basis, int interleave = 1);
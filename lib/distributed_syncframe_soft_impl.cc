@@ -14,6 +14,9 @@
 
 #include "distributed_syncframe_soft_impl.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+
+#include <stdexcept>
 
 namespace gr {
 namespace satellites {
@@ -34,13 +37,28 @@ distributed_syncframe_soft_impl::distributed_syncframe_soft_impl(
                      gr::io_signature::make(1, 1, sizeof(float)),
                      gr::io_signature::make(0, 0, 0)),
       d_threshold(threshold),
-      d_step(step)
+      d_step(step),
+      d_syncword_len(syncword.size()),
+      d_words((syncword.size() + 63) / 64),
+      d_syncword(d_words),
+      d_bits(d_words * step),
+      d_phase(0),
+      d_primed(false)
 {
+    if (d_syncword_len == 0) {
+        throw std::runtime_error("Syncword must not be empty");
+    }
+
+    const auto last_bits = d_syncword_len % 64;
+    d_last_word_mask = last_bits ? (uint64_t{ 1 } << last_bits) - 1 : ~uint64_t{ 0 };
+
     // look at LSB only, as in correlate_access_code_bb_impl.cc
-    for (auto s : syncword)
-        d_syncword.push_back(s & 1);
+    for (size_t j = 0; j < d_syncword_len; ++j) {
+        const auto k = d_syncword_len - 1 - j;
+        d_syncword[k / 64] |= static_cast<uint64_t>(syncword[j] & 1) << (k % 64);
+    }
 
-    set_history(d_syncword.size() * d_step);
+    set_history(d_syncword_len * d_step);
 
     message_port_register_out(pmt::mp("out"));
 }
@@ -50,25 +68,54 @@ distributed_syncframe_soft_impl::distributed_syncframe_soft_impl(
  */
 distributed_syncframe_soft_impl::~distributed_syncframe_soft_impl() {}
 
+const uint64_t* distributed_syncframe_soft_impl::push_sample(float sample)
+{
+    uint64_t* reg = &d_bits[d_phase * d_words];
+    uint64_t carry = !(sample < 0.0f);
+    for (size_t w = 0; w < d_words; ++w) {
+        const uint64_t next_carry = reg[w] >> 63;
+        reg[w] = (reg[w] << 1) | carry;
+        carry = next_carry;
+    }
+    reg[d_words - 1] &= d_last_word_mask;
+
+    if (++d_phase == d_step) {
+        d_phase = 0;
+    }
+    return reg;
+}
+
 int distributed_syncframe_soft_impl::work(int noutput_items,
                                           gr_vector_const_void_star& input_items,
                                           gr_vector_void_star& output_items)
 {
-    size_t match;
-
     const float* in = (const float*)input_items[0];
+    // The newest sample of the syncword candidate starting at in[i]
+    const size_t last = (d_syncword_len - 1) * d_step;
+
+    // The registers carry over between calls, so each sample is sliced only
+    // once. In the first call they are filled with the initial history.
+    if (!d_primed) {
+        for (size_t j = 0; j < last; ++j) {
+            push_sample(in[j]);
+        }
+        d_primed = true;
+    }
 
     for (int i = 0; i < noutput_items; i++) {
-        match = 0;
-        for (size_t j = 0; j < d_syncword.size(); ++j) {
-            match += (in[i + j * d_step] < 0.0) ^ d_syncword[j];
+        const uint64_t* reg = push_sample(in[i + last]);
+        uint64_t errors = 0;
+        for (size_t w = 0; w < d_words; ++w) {
+            uint64_t popcount;
+            volk_64u_popcnt(&popcount, reg[w] ^ d_syncword[w]);
+            errors += popcount;
         }
-        if (match >= d_syncword.size() - d_threshold) {
+        if (errors <= d_threshold) {
             // sync found
             message_port_pub(
                 pmt::mp("out"),
                 pmt::cons(pmt::PMT_NIL,
-                          pmt::init_f32vector(d_syncword.size() * d_step, in + i)));
+                          pmt::init_f32vector(d_syncword_len * d_step, in + i)));
         }
     }
 
@@ -13,6 +13,7 @@
 
 #include <satellites/distributed_syncframe_soft.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace gr {
@@ -23,7 +24,23 @@ class distributed_syncframe_soft_impl : public distributed_syncframe_soft
 private:
     const size_t d_threshold;
     const size_t d_step;
-    std::vector<uint8_t> d_syncword;
+    size_t d_syncword_len;
+
+    // The syncword and the sliced bits of the input are packed into words of
+    // 64 bits, with the last bit of the syncword (and the newest bit of the
+    // input) in the LSB of the first word. The input bits are kept in one
+    // such register for each phase modulo d_step, holding the last
+    // d_syncword_len bits at that phase.
+    size_t d_words;
+    uint64_t d_last_word_mask;
+    std::vector<uint64_t> d_syncword;
+    std::vector<uint64_t> d_bits;
+    size_t d_phase;
+    bool d_primed;
+
+    // Slices a sample and shifts it into the register of the current phase.
+    // Returns a pointer to the register.
+    const uint64_t* push_sample(float sample);
 
 public:
     distributed_syncframe_soft_impl(int threshold, const std::string& syncword, int step);
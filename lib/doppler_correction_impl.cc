@@ -10,13 +10,26 @@
 #include "doppler_correction_impl.h"
 #include <gnuradio/expj.h>
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace gr {
 namespace satellites {
 
+constexpr int doppler_correction_impl::d_block_size;
+
 doppler_correction::sptr
 doppler_correction::make(std::string& filename, double samp_rate, double t0)
 {
@@ -32,24 +45,115 @@ doppler_correction_impl::doppler_correction_impl(std::string& filename,
                      gr::io_signature::make(1, 1, sizeof(gr_complex))),
       d_phase(0.0),
       d_samp_rate(samp_rate),
+      d_freq_scale(2.0 * GR_M_PI / samp_rate),
       d_current_index(0),
       d_t0(t0),
       d_sample_t0(0),
+      d_size(0),
+      d_times(nullptr),
+      d_freqs(nullptr),
+      d_slopes(nullptr),
+      d_map(nullptr),
+      d_map_size(0),
       d_rx_time_key(pmt::mp("rx_time")),
       d_pck_n_key(pmt::mp("pck_n")),
       d_full_key(pmt::mp("full")),
       d_frac_key(pmt::mp("frac")),
       d_current_time(t0),
-      d_current_freq(0.0)
+      d_current_freq(0.0),
+      d_chirp_rate(0.0),
+      d_chirp(d_block_size, gr_complex(1.0f, 0.0f))
 {
     read_doppler_file(filename);
+    d_current_freq = freq(0);
+    seek(d_t0);
 }
 
-doppler_correction_impl::~doppler_correction_impl() {}
+doppler_correction_impl::~doppler_correction_impl()
+{
+#ifndef _WIN32
+    if (d_map) {
+        munmap(d_map, d_map_size);
+    }
+#endif
+}
 
 void doppler_correction_impl::read_doppler_file(std::string& filename)
+{
+    if (!map_binary_file(filename)) {
+        read_text_file(filename);
+    }
+}
+
+bool doppler_correction_impl::map_binary_file(const std::string& filename)
+{
+    std::ifstream input_file(filename, std::ios::binary);
+    doppler_file_header header;
+    if (!input_file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, doppler_file_magic, sizeof(header.magic)) != 0) {
+        return false;
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    throw std::runtime_error("binary Doppler files are not supported on big-endian "
+                             "machines");
+#endif
+    if (header.version != doppler_file_version) {
+        throw std::runtime_error("unsupported binary Doppler file version " +
+                                 std::to_string(header.version));
+    }
+    input_file.seekg(0, std::ios::end);
+    const uint64_t file_size = input_file.tellg();
+    if (header.size == 0) {
+        throw std::runtime_error("empty Doppler file");
+    }
+    if ((file_size - sizeof(header)) / (3 * sizeof(double)) < header.size) {
+        throw std::runtime_error("truncated binary Doppler file");
+    }
+    d_size = header.size;
+    d_map_size = sizeof(header) + 3 * sizeof(double) * d_size;
+
+    const double* table;
+#ifdef _WIN32
+    d_table.resize(3 * d_size);
+    input_file.seekg(sizeof(header));
+    input_file.read(reinterpret_cast<char*>(d_table.data()),
+                    3 * sizeof(double) * d_size);
+    table = d_table.data();
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("unable to open binary Doppler file");
+    }
+    d_map = mmap(nullptr, d_map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (d_map == MAP_FAILED) {
+        d_map = nullptr;
+        throw std::runtime_error("unable to map binary Doppler file");
+    }
+    table = reinterpret_cast<const double*>(static_cast<const char*>(d_map) +
+                                            sizeof(header));
+#endif
+    d_times = table;
+    d_freqs = table + d_size;
+    d_slopes = table + 2 * d_size;
+
+    // The destructor does not run if the constructor throws, so the file
+    // needs to be unmapped here
+    if (!std::is_sorted(d_times, d_times + d_size)) {
+#ifndef _WIN32
+        munmap(d_map, d_map_size);
+        d_map = nullptr;
+#endif
+        throw std::runtime_error("timestamps in binary Doppler file are not sorted");
+    }
+    return true;
+}
+
+void doppler_correction_impl::read_text_file(const std::string& filename)
 {
     std::ifstream input_file(filename);
+    std::vector<double> times;
+    std::vector<double> freqs;
     double time;
     double frequency;
 
@@ -59,11 +163,23 @@ void doppler_correction_impl::read_doppler_file(std::string& filename)
         }
         input_file >> time >> frequency;
         times.push_back(time);
-        freqs_rad_per_sample.push_back(2.0 * GR_M_PI * frequency / d_samp_rate);
+        freqs.push_back(frequency);
+    }
+
+    d_size = times.size();
+    d_table.resize(3 * d_size);
+    std::copy(times.begin(), times.end(), d_table.begin());
+    std::copy(freqs.begin(), freqs.end(), d_table.begin() + d_size);
+    for (size_t j = 0; j + 1 < d_size; ++j) {
+        const double dt = times[j + 1] - times[j];
+        d_table[2 * d_size + j] = dt > 0.0 ? (freqs[j + 1] - freqs[j]) / dt : 0.0;
     }
-    if (freqs_rad_per_sample.size() >= 1) {
-        d_current_freq = freqs_rad_per_sample[0];
+    if (d_size > 0) {
+        d_table[3 * d_size - 1] = 0.0;
     }
+    d_times = d_table.data();
+    d_freqs = d_times + d_size;
+    d_slopes = d_freqs + d_size;
 }
 
 void doppler_correction_impl::set_time(double t)
@@ -75,6 +191,97 @@ void doppler_correction_impl::set_time(double t)
     adjust_current_index();
 }
 
+void doppler_correction_impl::seek(double time)
+{
+    // Usually time is in the current or in the next segment, so these are
+    // checked before doing a binary search
+    if (d_times[d_current_index] <= time) {
+        if (d_current_index + 1 == d_size || d_times[d_current_index + 1] > time) {
+            return;
+        }
+        if (d_current_index + 2 == d_size || d_times[d_current_index + 2] > time) {
+            ++d_current_index;
+            return;
+        }
+    }
+    // Find the last timestamp which is smaller or equal than time, or the
+    // first one if time is before the beginning of the file
+    const auto next = std::upper_bound(d_times, d_times + d_size, time);
+    d_current_index = next == d_times ? 0 : next - d_times - 1;
+}
+
+double doppler_correction_impl::interpolate_freq(double time) const
+{
+    if ((time < d_times[d_current_index]) || (d_current_index + 1 == d_size)) {
+        // We are before the beginning or past the end of the file, so we
+        // maintain a constant frequency.
+        return freq(d_current_index);
+    }
+    // Linearly interpolate frequency
+    return d_freq_scale * (d_freqs[d_current_index] +
+                           d_slopes[d_current_index] * (time - d_times[d_current_index]));
+}
+
+int doppler_correction_impl::segment_end(int j, int noutput_items, double* chirp_rate)
+{
+    // The segment ends at the first sample whose time is at least the next
+    // timestamp in the file
+    double end_time;
+    if (sample_time(j) < d_times[d_current_index]) {
+        *chirp_rate = 0.0;
+        end_time = d_times[d_current_index];
+    } else if (d_current_index + 1 == d_size) {
+        *chirp_rate = 0.0;
+        return noutput_items;
+    } else {
+        *chirp_rate = d_freq_scale * d_slopes[d_current_index] / d_samp_rate;
+        end_time = d_times[d_current_index + 1];
+    }
+
+    const double samples =
+        std::ceil((end_time - sample_time(j)) * d_samp_rate) + static_cast<double>(j);
+    if (samples >= static_cast<double>(noutput_items)) {
+        return noutput_items;
+    }
+    int end = std::max(static_cast<int>(samples), j + 1);
+    // Fix rounding errors in the estimate
+    while (end > j + 1 && sample_time(end - 1) >= end_time) {
+        --end;
+    }
+    while (end < noutput_items && sample_time(end) < end_time) {
+        ++end;
+    }
+    return end;
+}
+
+void doppler_correction_impl::rotate(
+    const gr_complex* in, gr_complex* out, int n, double freq, double chirp_rate)
+{
+    if (chirp_rate != 0.0) {
+        if (chirp_rate != d_chirp_rate) {
+            d_chirp_rate = chirp_rate;
+            for (int m = 0; m < d_block_size; ++m) {
+                d_chirp[m] = std::polar(1.0, -0.5 * chirp_rate * m * (m + 1));
+            }
+        }
+        volk_32fc_x2_multiply_32fc(out, in, d_chirp.data(), n);
+        in = out;
+    }
+
+    // The phase of sample m of the block is
+    // d_phase + (m + 1) * freq + chirp_rate * m * (m + 1) / 2
+    gr_complex phase(std::polar(1.0, -(d_phase + freq)));
+    const gr_complex phase_inc(std::polar(1.0, -freq));
+#if VOLK_VERSION >= 030100
+    volk_32fc_s32fc_x2_rotator2_32fc(out, in, &phase_inc, &phase, n);
+#else
+    volk_32fc_s32fc_x2_rotator_32fc(out, in, phase_inc, &phase, n);
+#endif
+
+    d_phase += n * freq + 0.5 * chirp_rate * (n - 1) * n;
+    phase_wrap();
+}
+
 int doppler_correction_impl::work(int noutput_items,
                                   gr_vector_const_void_star& input_items,
                                   gr_vector_void_star& output_items)
@@ -83,9 +290,8 @@ int doppler_correction_impl::work(int noutput_items,
     auto in = static_cast<const gr_complex*>(input_items[0]);
     auto out = static_cast<gr_complex*>(output_items[0]);
 
-    std::vector<gr::tag_t> tags;
-    get_tags_in_window(tags, 0, 0, noutput_items);
-    for (const auto& tag : tags) {
+    get_tags_in_window(d_tags, 0, 0, noutput_items);
+    for (const auto& tag : d_tags) {
         double t0;
         bool set = false;
         if (pmt::eqv(tag.key, d_rx_time_key)) {
@@ -116,35 +322,22 @@ int doppler_correction_impl::work(int noutput_items,
         }
     }
 
-    double time = 0.0;
-    double freq = 0.0;
-    for (int j = 0; j < noutput_items; ++j) {
-        time = d_t0 + static_cast<double>(static_cast<int64_t>(nitems_written(0)) -
-                                          static_cast<int64_t>(d_sample_t0) +
-                                          static_cast<int64_t>(j)) /
-                          d_samp_rate;
+    int j = 0;
+    while (j < noutput_items) {
         // Advance d_current_index so that the next time is greater than the
         // current.
-        while (d_current_index + 1 < times.size() && times[d_current_index + 1] <= time) {
-            ++d_current_index;
-        }
-        if ((time < times[d_current_index]) || (d_current_index + 1 == times.size())) {
-            // We are before the beginning or past the end of the file, so we
-            // maintain a constant frequency.
-            freq = freqs_rad_per_sample[d_current_index];
-        } else {
-            // Linearly interpolate frequency
-            double alpha = (time - times[d_current_index]) /
-                           (times[d_current_index + 1] - times[d_current_index]);
-            freq = (1.0 - alpha) * freqs_rad_per_sample[d_current_index] +
-                   alpha * freqs_rad_per_sample[d_current_index + 1];
+        seek(sample_time(j));
+        double chirp_rate;
+        const int end = segment_end(j, noutput_items, &chirp_rate);
+        while (j < end) {
+            const int n = std::min(end - j, d_block_size);
+            rotate(&in[j], &out[j], n, interpolate_freq(sample_time(j)), chirp_rate);
+            j += n;
         }
-        d_phase += freq;
-        phase_wrap();
-        const gr_complex nco = gr_expj(-static_cast<float>(d_phase));
-        gr::fast_cc_multiply(out[j], in[j], nco);
     }
 
+    const double time = sample_time(noutput_items - 1);
+    const double freq = interpolate_freq(time);
     d_current_freq = freq;
     d_current_time = time;
 
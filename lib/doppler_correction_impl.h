@@ -12,24 +12,52 @@
 
 #include <gnuradio/math.h>
 #include <satellites/doppler_correction.h>
+#include <volk/volk_alloc.hh>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
 namespace gr {
 namespace satellites {
 
+// Header of the binary Doppler files. It is followed by the arrays of
+// timestamps, frequencies and slopes, each of them containing size
+// little-endian doubles.
+struct doppler_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t reserved2;
+};
+
+constexpr char doppler_file_magic[8] = { 'G', 'R', 'S', 'D', 'O', 'P', 'P', 'L' };
+constexpr uint32_t doppler_file_version = 1;
+
 class doppler_correction_impl : public doppler_correction
 {
 private:
     double d_phase;
     double d_samp_rate;
+    // Converts from Hz to radians per sample
+    double d_freq_scale;
     size_t d_current_index;
     double d_t0;
     uint64_t d_sample_t0;
-    std::vector<double> times;
-    std::vector<double> freqs_rad_per_sample;
     std::vector<tag_t> d_tags;
 
+    // The Doppler table has d_size entries, which are stored as three
+    // arrays: timestamps (s), frequencies (Hz) and slopes (Hz/s) of the
+    // segment that begins at each timestamp. They point either to a memory
+    // mapped binary file or to d_table.
+    size_t d_size;
+    const double* d_times;
+    const double* d_freqs;
+    const double* d_slopes;
+    std::vector<double> d_table;
+    void* d_map;
+    size_t d_map_size;
+
     // Used by UHD
     const pmt::pmt_t d_rx_time_key;
 
@@ -41,25 +69,42 @@ private:
     double d_current_time;
     double d_current_freq;
 
-    // Implementation taken from gr::block::control_loop
-    void phase_wrap()
-    {
-        while (d_phase > (2 * GR_M_PI))
-            d_phase -= 2 * GR_M_PI;
-        while (d_phase < (-2 * GR_M_PI))
-            d_phase += 2 * GR_M_PI;
-    }
+    // The NCO is generated in blocks of at most d_block_size samples with a
+    // VOLK rotator, whose phase and frequency are computed in double
+    // precision at the start of each block. Within a segment of the
+    // Doppler file the frequency changes by d_chirp_rate radians per sample
+    // per sample, which is applied by multiplying by d_chirp, where
+    // d_chirp[m] = exp(-j * d_chirp_rate * m * (m + 1) / 2).
+    constexpr static int d_block_size = 512;
+    double d_chirp_rate;
+    volk::vector<gr_complex> d_chirp;
+
+    void phase_wrap() { d_phase = std::fmod(d_phase, 2 * GR_M_PI); }
 
-    // Called after a time update. Makes the current index go backwards if
-    // needed because of a time update "to the past".
-    void adjust_current_index()
+    double sample_time(int j)
     {
-        while ((d_current_index > 0) && (times[d_current_index] > d_t0)) {
-            --d_current_index;
-        }
+        return d_t0 + static_cast<double>(static_cast<int64_t>(nitems_written(0)) -
+                                          static_cast<int64_t>(d_sample_t0) +
+                                          static_cast<int64_t>(j)) /
+                          d_samp_rate;
     }
 
+    double freq(size_t index) const { return d_freq_scale * d_freqs[index]; }
+
+    // Called after a time update, which can jump to any point of the file
+    void adjust_current_index() { seek(d_t0); }
+
+    void seek(double time);
     void read_doppler_file(std::string& filename);
+    bool map_binary_file(const std::string& filename);
+    void read_text_file(const std::string& filename);
+    double interpolate_freq(double time) const;
+    int segment_end(int j, int noutput_items, double* chirp_rate);
+    void rotate(const gr_complex* in,
+                gr_complex* out,
+                int n,
+                double freq,
+                double chirp_rate);
 
 public:
     doppler_correction_impl(std::string& filename, double samp_rate, double t0);
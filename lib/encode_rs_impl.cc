@@ -13,6 +13,7 @@
 #endif
 
 #include "encode_rs_impl.h"
+#include "rs_cache.h"
 #include <gnuradio/io_signature.h>
 
 #include <algorithm>
@@ -20,6 +21,7 @@
 
 extern "C" {
 #include "libfec/fec.h"
+#include "libfec/rs_simd.h"
 }
 
 #include "rs.h"
@@ -47,16 +49,10 @@ encode_rs_impl::encode_rs_impl(bool dual_basis, int interleave)
           "encode_rs", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)),
       d_interleave(interleave)
 {
-    static constexpr int parity_offset = d_ccsds_nn - d_ccsds_nroots;
-    if (dual_basis) {
-        d_encode_rs = [](uint8_t* data) {
-            encode_rs_ccsds(data, &data[parity_offset], 0);
-        };
-    } else {
-        d_encode_rs = [](uint8_t* data) { encode_rs_8(data, &data[parity_offset], 0); };
-    }
-    d_rs_codeword.resize(d_ccsds_nn);
+    d_nn = d_ccsds_nn;
     d_nroots = d_ccsds_nroots;
+    d_simd = rs_simd_ccsds();
+    d_dual_basis = dual_basis;
 
     check_interleave();
     set_message_ports();
@@ -71,18 +67,14 @@ encode_rs_impl::encode_rs_impl(
           "encode_rs", gr::io_signature::make(0, 0, 0), gr::io_signature::make(0, 0, 0)),
       d_interleave(interleave)
 {
-    d_rs_p = init_rs_char(symsize, gfpoly, fcr, prim, nroots, 0);
-    const int codeword_size = (1U << symsize) - 1;
-    const int parity_offset = codeword_size - nroots;
+    d_rs_p = get_rs_char(symsize, gfpoly, fcr, prim, nroots);
     if (!d_rs_p) {
         throw std::runtime_error("Unable to initialize Reed-Solomon definition");
     }
-    d_encode_rs = [this, parity_offset](uint8_t* data) {
-        return encode_rs_char(d_rs_p, data, &data[parity_offset]);
-    };
 
-    d_rs_codeword.resize((1U << symsize) - 1);
+    d_nn = (1U << symsize) - 1;
     d_nroots = nroots;
+    d_simd = rs_simd_char(d_rs_p.get());
 
     check_interleave();
     set_message_ports();
@@ -106,12 +98,7 @@ void encode_rs_impl::set_message_ports()
 /*
  * Our virtual destructor.
  */
-encode_rs_impl::~encode_rs_impl()
-{
-    if (d_rs_p) {
-        free_rs_char(d_rs_p);
-    }
-}
+encode_rs_impl::~encode_rs_impl() {}
 
 void encode_rs_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required) {}
 
@@ -125,41 +112,48 @@ int encode_rs_impl::general_work(int noutput_items,
 
 void encode_rs_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
-    auto msg = pmt::u8vector_elements(pmt::cdr(pmt_msg));
+    size_t size;
+    const uint8_t* msg = pmt::u8vector_elements(pmt::cdr(pmt_msg), size);
 
-    if (msg.size() % d_interleave != 0) {
+    if (size % d_interleave != 0) {
         d_logger->error("Reed-Solomon message size not divisible by interleave "
                         "depth. size = {:d}, interleave = {:d}",
-                        msg.size(),
+                        size,
                         d_interleave);
         return;
     }
 
-    int rs_kk = msg.size() / d_interleave;
+    int rs_kk = size / d_interleave;
 
-    if ((unsigned)(rs_kk + d_nroots) > d_rs_codeword.size()) {
+    if (rs_kk + d_nroots > d_nn) {
         d_logger->error("Reed-Solomon message too large. size = {:d}, interleave "
                         "= {:d}, RS code ({:d}, {:d})",
-                        msg.size(),
+                        size,
                         d_interleave,
-                        d_rs_codeword.size(),
-                        d_rs_codeword.size() - d_nroots);
+                        d_nn,
+                        d_nn - d_nroots);
         return;
     }
 
-    d_output_frame.resize(msg.size() + d_interleave * d_nroots);
-    const auto pad = d_rs_codeword.size() - rs_kk - d_nroots;
+    // The code is systematic, so the interleaved message is followed by the
+    // interleaved parity of all the codewords
+    d_output_frame.resize(size + d_interleave * d_nroots);
+    std::copy(msg, msg + size, d_output_frame.begin());
+    auto parity = &d_output_frame[size];
 
-    for (int j = 0; j < d_interleave; ++j) {
-        std::fill(d_rs_codeword.begin(), d_rs_codeword.begin() + pad, 0);
-        for (int k = 0; k < rs_kk; ++k) {
-            d_rs_codeword[pad + k] = msg[j + k * d_interleave];
+    if (d_dual_basis) {
+        d_conventional.resize(size);
+        for (size_t j = 0; j < size; ++j) {
+            d_conventional[j] = Tal1tab[msg[j]];
         }
+        msg = d_conventional.data();
+    }
 
-        d_encode_rs(d_rs_codeword.data());
+    rs_simd_encode(d_simd, msg, rs_kk, d_interleave, parity);
 
-        for (int k = 0; k < rs_kk + d_nroots; ++k) {
-            d_output_frame[j + k * d_interleave] = d_rs_codeword[pad + k];
+    if (d_dual_basis) {
+        for (int j = 0; j < d_interleave * d_nroots; ++j) {
+            parity[j] = Taltab[parity[j]];
         }
     }
 
@@ -14,9 +14,11 @@
 #include <satellites/encode_rs.h>
 
 #include <cstdint>
-#include <functional>
+#include <memory>
 #include <vector>
 
+struct rs_simd;
+
 namespace gr {
 namespace satellites {
 
@@ -24,12 +26,16 @@ class encode_rs_impl : public encode_rs
 {
 private:
     int d_interleave;
-    std::vector<uint8_t> d_rs_codeword;
     std::vector<uint8_t> d_output_frame;
+    int d_nn;
     int d_nroots;
-    void* d_rs_p = NULL;
+    std::shared_ptr<void> d_rs_p;
 
-    std::function<void(uint8_t*)> d_encode_rs;
+    // All the interleaved codewords are encoded at once with the SIMD
+    // encoder, which works in the conventional basis
+    const struct rs_simd* d_simd = NULL;
+    bool d_dual_basis = false;
+    std::vector<uint8_t> d_conventional;
 
     constexpr static int d_ccsds_nn = 255;
     constexpr static int d_ccsds_nroots = 32;
@@ -10,156 +10,220 @@
 
 #include "fixedlen_to_pdu_impl.h"
 #include <gnuradio/io_signature.h>
-#include <cstring>
+#include <volk/volk.h>
+#include <algorithm>
 #include <stdexcept>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PACK_SSSE3
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define PACK_NEON
+#include <arm_neon.h>
+#endif
+
 namespace gr {
 namespace satellites {
 
+namespace {
+
+// Packs the LSBs of 8 bytes into a byte, MSB first. The multiplication moves
+// the bit in byte k to bit 63 - k without carries.
+inline uint8_t pack8(const uint8_t* bits)
+{
+    const uint64_t x =
+        (static_cast<uint64_t>(bits[0]) | static_cast<uint64_t>(bits[1]) << 8 |
+         static_cast<uint64_t>(bits[2]) << 16 | static_cast<uint64_t>(bits[3]) << 24 |
+         static_cast<uint64_t>(bits[4]) << 32 | static_cast<uint64_t>(bits[5]) << 40 |
+         static_cast<uint64_t>(bits[6]) << 48 | static_cast<uint64_t>(bits[7]) << 56) &
+        UINT64_C(0x0101010101010101);
+    return (x * UINT64_C(0x8040201008040201)) >> 56;
+}
+
+void pack_port(const uint8_t* bits, size_t nbytes, uint8_t* out)
+{
+    for (size_t j = 0; j < nbytes; ++j) {
+        out[j] = pack8(&bits[8 * j]);
+    }
+}
+
+#ifdef PACK_SSSE3
+// The order of the bytes in each group of 8 is reversed and their LSBs are
+// moved to the MSBs, so that movemask gives two packed bytes
+__attribute__((target("ssse3"))) void
+pack_ssse3(const uint8_t* bits, size_t nbytes, uint8_t* out)
+{
+    const __m128i reverse =
+        _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+    size_t j = 0;
+    for (; j + 2 <= nbytes; j += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bits[8 * j]));
+        x = _mm_slli_epi16(_mm_shuffle_epi8(x, reverse), 7);
+        const int mask = _mm_movemask_epi8(x);
+        out[j] = mask;
+        out[j + 1] = mask >> 8;
+    }
+    pack_port(&bits[8 * j], nbytes - j, &out[j]);
+}
+
+bool have_ssse3() { return __builtin_cpu_supports("ssse3"); }
+#endif
+
+#ifdef PACK_NEON
+void pack_neon(const uint8_t* bits, size_t nbytes, uint8_t* out)
+{
+    const int8x8_t shifts = { 7, 6, 5, 4, 3, 2, 1, 0 };
+    const uint8x8_t one = vdup_n_u8(1);
+    for (size_t j = 0; j < nbytes; ++j) {
+        const uint8x8_t x = vand_u8(vld1_u8(&bits[8 * j]), one);
+        out[j] = vaddv_u8(vshl_u8(x, shifts));
+    }
+}
+#endif
+
+} // namespace
+
 fixedlen_to_pdu::sptr fixedlen_to_pdu::make(types::vector_type type,
                                             const std::string& syncword_tag,
                                             size_t packet_len,
-                                            bool pack)
+                                            bool pack,
+                                            bool quantize,
+                                            float scale)
 {
     return gnuradio::make_block_sptr<fixedlen_to_pdu_impl>(
-        type, syncword_tag, packet_len, pack);
+        type, syncword_tag, packet_len, pack, quantize, scale);
 }
 
 fixedlen_to_pdu_impl::fixedlen_to_pdu_impl(types::vector_type type,
                                            const std::string& syncword_tag,
                                            size_t packet_len,
-                                           bool pack)
+                                           bool pack,
+                                           bool quantize,
+                                           float scale)
     : gr::sync_block("fixedlen_to_pdu",
                      gr::io_signature::make(1, 1, pdu::itemsize(type)),
                      gr::io_signature::make(0, 0, 0)),
       d_type(type),
       d_pack(pack),
+      d_quantize(quantize),
+      d_scale(scale),
       d_packetlen(packet_len),
-      d_packet_nbytes(packet_len * pdu::itemsize(type)),
+      d_itemsize(pdu::itemsize(type)),
       d_pdu_items(pack ? packet_len / 8 : packet_len),
       d_syncword_tag(pmt::mp(syncword_tag)),
-      d_history((packet_len - 1) * pdu::itemsize(type)),
-      d_write_ptr_item(0),
-      d_write_ptr_byte(0),
-      d_packet(packet_len * pdu::itemsize(type)),
-      d_tag_offsets(0)
+      d_packet(pack ? packet_len / 8 : 0),
+      d_quantized(quantize ? packet_len : 0),
+      d_tag_offsets(packet_len),
+      d_tag_offsets_head(0),
+      d_tag_offsets_count(0)
 {
+    if (packet_len == 0) {
+        throw std::runtime_error("packet_len must be positive");
+    }
     if (pack && type != types::byte_t) {
         throw std::runtime_error("pack can only be used with byte_t");
     }
     if (pack && packet_len % 8 != 0) {
         throw std::runtime_error("when using pack, packet_len must be a multiple of 8");
     }
+    if (quantize && type != types::float_t) {
+        throw std::runtime_error("quantize can only be used with float_t");
+    }
+
+    // The input buffer holds the previous packet_len - 1 items before
+    // in[0], so the packets that start in a previous call to work() are
+    // contiguous with the current items and can be read directly from it.
+    set_history(packet_len);
+
     message_port_register_out(msgport_names::pdus());
 }
 
 fixedlen_to_pdu_impl::~fixedlen_to_pdu_impl() {}
 
+void fixedlen_to_pdu_impl::push_tag_offset(uint64_t offset)
+{
+    const size_t size = d_tag_offsets.size();
+    if (d_tag_offsets_count == size) {
+        std::vector<uint64_t> offsets(2 * size);
+        for (size_t j = 0; j < d_tag_offsets_count; ++j) {
+            offsets[j] = d_tag_offsets[(d_tag_offsets_head + j) % size];
+        }
+        d_tag_offsets.swap(offsets);
+        d_tag_offsets_head = 0;
+    }
+    d_tag_offsets[(d_tag_offsets_head + d_tag_offsets_count) % d_tag_offsets.size()] =
+        offset;
+    ++d_tag_offsets_count;
+}
+
 int fixedlen_to_pdu_impl::work(int noutput_items,
                                gr_vector_const_void_star& input_items,
                                gr_vector_void_star& output_items)
 {
     auto in = static_cast<const uint8_t*>(input_items[0]);
 
+    // The tags in this window come after all the pending tags, so the ring
+    // stays sorted
     get_tags_in_window(d_tags_in_window, 0, 0, noutput_items, d_syncword_tag);
-    for (auto tag : d_tags_in_window) {
-        d_tag_offsets.push_back(tag.offset);
+    std::sort(d_tags_in_window.begin(),
+              d_tags_in_window.end(),
+              [](const tag_t& a, const tag_t& b) { return a.offset < b.offset; });
+    for (const auto& tag : d_tags_in_window) {
+        push_tag_offset(tag.offset);
     }
 
-    std::list<uint64_t> tag_offsets_copy = d_tag_offsets;
-    for (auto tag_offset : tag_offsets_copy) {
-        if (tag_offset + d_packetlen <= nitems_read(0) + noutput_items) {
-            // Packet ends in current input_items buffer
-            if (tag_offset >= nitems_read(0)) {
-                // Packet doesn't use history
-                std::memcpy(d_packet.data(),
-                            &in[(tag_offset - nitems_read(0)) * pdu::itemsize(d_type)],
-                            d_packet_nbytes);
-            } else if (d_write_ptr_item + tag_offset >= nitems_read(0)) {
-                // Packet starts before the write pointer
-                size_t start = (d_write_ptr_item + tag_offset - nitems_read(0)) *
-                               pdu::itemsize(d_type);
-                size_t len = d_write_ptr_byte - start;
-                std::memcpy(d_packet.data(), &d_history[start], len);
-                std::memcpy(&d_packet[len], &in[0], d_packet_nbytes - len);
-            } else {
-                // Packet starts after the write pointer
-                size_t start =
-                    (d_write_ptr_item + tag_offset + d_packetlen - 1 - nitems_read(0)) *
-                    pdu::itemsize(d_type);
-                size_t len = d_history.size() - start;
-                std::memcpy(d_packet.data(), &d_history[start], len);
-                std::memcpy(&d_packet[len], d_history.data(), d_write_ptr_byte);
-                std::memcpy(&d_packet[len + d_write_ptr_byte],
-                            &in[0],
-                            d_packet_nbytes - len - d_write_ptr_byte);
-            }
-
-            d_tag_offsets.erase(
-                std::find(d_tag_offsets.begin(), d_tag_offsets.end(), tag_offset));
-            if (d_pack) {
-                pack_packet();
-            }
+    // Send the packets that end in the current input_items buffer. The item
+    // nitems_read(0) is in[d_packetlen - 1].
+    const uint64_t window_end = nitems_read(0) + noutput_items;
+    while (d_tag_offsets_count > 0) {
+        const uint64_t tag_offset = d_tag_offsets[d_tag_offsets_head];
+        if (tag_offset + d_packetlen > window_end) {
+            break;
+        }
+        if (++d_tag_offsets_head == d_tag_offsets.size()) {
+            d_tag_offsets_head = 0;
+        }
+        --d_tag_offsets_count;
+
+        const uint8_t* packet =
+            &in[(tag_offset + d_packetlen - 1 - nitems_read(0)) * d_itemsize];
+        if (d_quantize) {
+            volk_32f_s32f_convert_8i(d_quantized.data(),
+                                     reinterpret_cast<const float*>(packet),
+                                     d_scale,
+                                     d_packetlen);
             message_port_pub(
                 msgport_names::pdus(),
                 pmt::cons(pmt::PMT_NIL,
-                          pdu::make_pdu_vector(d_type, d_packet.data(), d_pdu_items)));
+                          pmt::init_s8vector(d_packetlen, d_quantized.data())));
+            continue;
+        }
+        if (d_pack) {
+            pack_packet(packet);
+            packet = d_packet.data();
         }
+        message_port_pub(
+            msgport_names::pdus(),
+            pmt::cons(pmt::PMT_NIL, pdu::make_pdu_vector(d_type, packet, d_pdu_items)));
     }
 
-    update_history(in, noutput_items);
     return noutput_items;
 }
 
-void fixedlen_to_pdu_impl::pack_packet()
-{
-    for (size_t j = 0; j < d_pdu_items; ++j) {
-        uint8_t b = 0;
-        for (int k = 0; k < 8; ++k) {
-            b <<= 1;
-            b |= d_packet[8 * j + k] & 1;
-        }
-        d_packet[j] = b;
-    }
-}
-
-void fixedlen_to_pdu_impl::update_history(const uint8_t* in, int noutput_items)
+void fixedlen_to_pdu_impl::pack_packet(const uint8_t* bits)
 {
-    size_t start;
-    size_t len;
-    size_t len_items;
-    const size_t history_items = d_packetlen - 1;
-    if (static_cast<size_t>(noutput_items) > history_items) {
-        start = (noutput_items - history_items) * pdu::itemsize(d_type);
-        len = d_history.size();
-        len_items = history_items;
-    } else {
-        start = 0;
-        len = noutput_items * pdu::itemsize(d_type);
-        len_items = noutput_items;
-    }
-    size_t len2;
-    size_t len2_items;
-    if (d_write_ptr_byte + len <= d_history.size()) {
-        len2 = len;
-        len2_items = len_items;
-    } else {
-        len2 = d_history.size() - d_write_ptr_byte;
-        len2_items = history_items - d_write_ptr_item;
-    }
-    std::memcpy(&d_history[d_write_ptr_byte], &in[start], len2);
-    if (len2 < len) {
-        std::memcpy(&d_history[0], &in[start + len2], len - len2);
-        d_write_ptr_byte = len - len2;
-        d_write_ptr_item = len_items - len2_items;
-    } else {
-        d_write_ptr_byte += len;
-        d_write_ptr_item += len_items;
-        if (d_write_ptr_byte == d_history.size()) {
-            d_write_ptr_byte = 0;
-            d_write_ptr_item = 0;
-        }
+#if defined(PACK_SSSE3)
+    if (have_ssse3()) {
+        pack_ssse3(bits, d_pdu_items, d_packet.data());
+        return;
     }
+#elif defined(PACK_NEON)
+    pack_neon(bits, d_pdu_items, d_packet.data());
+    return;
+#endif
+    pack_port(bits, d_pdu_items, d_packet.data());
 }
 
 } /* namespace satellites */
@@ -12,7 +12,6 @@
 #define INCLUDED_SATELLITES_FIXEDLEN_TO_PDU_IMPL_H
 
 #include <satellites/fixedlen_to_pdu.h>
-#include <list>
 #include <vector>
 
 namespace gr {
@@ -23,25 +22,33 @@ class fixedlen_to_pdu_impl : public fixedlen_to_pdu
 private:
     const types::vector_type d_type;
     const bool d_pack;
+    const bool d_quantize;
+    const float d_scale;
     const size_t d_packetlen;
-    const size_t d_packet_nbytes;
+    const size_t d_itemsize;
     const size_t d_pdu_items;
     const pmt::pmt_t d_syncword_tag;
-    std::vector<uint8_t> d_history;
-    size_t d_write_ptr_item;
-    size_t d_write_ptr_byte;
     std::vector<uint8_t> d_packet;
+    std::vector<int8_t> d_quantized;
     std::vector<tag_t> d_tags_in_window;
-    std::list<uint64_t> d_tag_offsets;
 
-    void pack_packet();
-    void update_history(const uint8_t* in, int noutput_items);
+    // Offsets of the tags whose packets have not been sent yet, sorted, in
+    // a ring buffer that only grows if there are more than d_packetlen
+    // pending tags
+    std::vector<uint64_t> d_tag_offsets;
+    size_t d_tag_offsets_head;
+    size_t d_tag_offsets_count;
+
+    void push_tag_offset(uint64_t offset);
+    void pack_packet(const uint8_t* bits);
 
 public:
     fixedlen_to_pdu_impl(types::vector_type type,
                          const std::string& syncword_tag,
                          size_t packet_len,
-                         bool pack);
+                         bool pack,
+                         bool quantize,
+                         float scale);
     ~fixedlen_to_pdu_impl();
 
     int work(int noutput_items,
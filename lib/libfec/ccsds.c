@@ -43,3 +43,396 @@ char CCSDS_poly[] = {
     0, 249, 59, 66, 4,   43, 126, 251, 97,  30,  3,  213, 50, 66, 170, 5, 24,
     5, 170, 66, 50, 213, 3,  30,  97,  251, 126, 43, 4,   66, 59, 249, 0,
 };
+
+unsigned char CCSDS_syndrome_tab[] = {
+    0x00, 0xca, 0x13, 0xd9, 0x26, 0xec, 0x35, 0xff,
+    0x4c, 0x86, 0x5f, 0x95, 0x6a, 0xa0, 0x79, 0xb3,
+    0x00, 0x98, 0xb7, 0x2f, 0xe9, 0x71, 0x5e, 0xc6,
+    0x55, 0xcd, 0xe2, 0x7a, 0xbc, 0x24, 0x0b, 0x93,
+    0x00, 0xa2, 0xc3, 0x61, 0x01, 0xa3, 0xc2, 0x60,
+    0x02, 0xa0, 0xc1, 0x63, 0x03, 0xa1, 0xc0, 0x62,
+    0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c,
+    0x20, 0x24, 0x28, 0x2c, 0x30, 0x34, 0x38, 0x3c,
+    0x00, 0x94, 0xaf, 0x3b, 0xd9, 0x4d, 0x76, 0xe2,
+    0x35, 0xa1, 0x9a, 0x0e, 0xec, 0x78, 0x43, 0xd7,
+    0x00, 0x6a, 0xd4, 0xbe, 0x2f, 0x45, 0xfb, 0x91,
+    0x5e, 0x34, 0x8a, 0xe0, 0x71, 0x1b, 0xa5, 0xcf,
+    0x00, 0xba, 0xf3, 0x49, 0x61, 0xdb, 0x92, 0x28,
+    0xc2, 0x78, 0x31, 0x8b, 0xa3, 0x19, 0x50, 0xea,
+    0x00, 0x03, 0x06, 0x05, 0x0c, 0x0f, 0x0a, 0x09,
+    0x18, 0x1b, 0x1e, 0x1d, 0x14, 0x17, 0x12, 0x11,
+    0x00, 0x6f, 0xde, 0xb1, 0x3b, 0x54, 0xe5, 0x8a,
+    0x76, 0x19, 0xa8, 0xc7, 0x4d, 0x22, 0x93, 0xfc,
+    0x00, 0xec, 0x5f, 0xb3, 0xbe, 0x52, 0xe1, 0x0d,
+    0xfb, 0x17, 0xa4, 0x48, 0x45, 0xa9, 0x1a, 0xf6,
+    0x00, 0xb0, 0xe7, 0x57, 0x49, 0xf9, 0xae, 0x1e,
+    0x92, 0x22, 0x75, 0xc5, 0xdb, 0x6b, 0x3c, 0x8c,
+    0x00, 0xa3, 0xc1, 0x62, 0x05, 0xa6, 0xc4, 0x67,
+    0x0a, 0xa9, 0xcb, 0x68, 0x0f, 0xac, 0xce, 0x6d,
+    0x00, 0x8e, 0x9b, 0x15, 0xb1, 0x3f, 0x2a, 0xa4,
+    0xe5, 0x6b, 0x7e, 0xf0, 0x54, 0xda, 0xcf, 0x41,
+    0x00, 0x4d, 0x9a, 0xd7, 0xb3, 0xfe, 0x29, 0x64,
+    0xe1, 0xac, 0x7b, 0x36, 0x52, 0x1f, 0xc8, 0x85,
+    0x00, 0x74, 0xe8, 0x9c, 0x57, 0x23, 0xbf, 0xcb,
+    0xae, 0xda, 0x46, 0x32, 0xf9, 0x8d, 0x11, 0x65,
+    0x00, 0xdb, 0x31, 0xea, 0x62, 0xb9, 0x53, 0x88,
+    0xc4, 0x1f, 0xf5, 0x2e, 0xa6, 0x7d, 0x97, 0x4c,
+    0x00, 0xa7, 0xc9, 0x6e, 0x15, 0xb2, 0xdc, 0x7b,
+    0x2a, 0x8d, 0xe3, 0x44, 0x3f, 0x98, 0xf6, 0x51,
+    0x00, 0x54, 0xa8, 0xfc, 0xd7, 0x83, 0x7f, 0x2b,
+    0x29, 0x7d, 0x81, 0xd5, 0xfe, 0xaa, 0x56, 0x02,
+    0x00, 0x27, 0x4e, 0x69, 0x9c, 0xbb, 0xd2, 0xf5,
+    0xbf, 0x98, 0xf1, 0xd6, 0x23, 0x04, 0x6d, 0x4a,
+    0x00, 0xf9, 0x75, 0x8c, 0xea, 0x13, 0x9f, 0x66,
+    0x53, 0xaa, 0x26, 0xdf, 0xb9, 0x40, 0xcc, 0x35,
+    0x00, 0xd8, 0x37, 0xef, 0x6e, 0xb6, 0x59, 0x81,
+    0xdc, 0x04, 0xeb, 0x33, 0xb2, 0x6a, 0x85, 0x5d,
+    0x00, 0x3f, 0x7e, 0x41, 0xfc, 0xc3, 0x82, 0xbd,
+    0x7f, 0x40, 0x01, 0x3e, 0x83, 0xbc, 0xfd, 0xc2,
+    0x00, 0xb8, 0xf7, 0x4f, 0x69, 0xd1, 0x9e, 0x26,
+    0xd2, 0x6a, 0x25, 0x9d, 0xbb, 0x03, 0x4c, 0xf4,
+    0x00, 0x23, 0x46, 0x65, 0x8c, 0xaf, 0xca, 0xe9,
+    0x9f, 0xbc, 0xd9, 0xfa, 0x13, 0x30, 0x55, 0x76,
+    0x00, 0x5a, 0xb4, 0xee, 0xef, 0xb5, 0x5b, 0x01,
+    0x59, 0x03, 0xed, 0xb7, 0xb6, 0xec, 0x02, 0x58,
+    0x00, 0xb2, 0xe3, 0x51, 0x41, 0xf3, 0xa2, 0x10,
+    0x82, 0x30, 0x61, 0xd3, 0xc3, 0x71, 0x20, 0x92,
+    0x00, 0x72, 0xe4, 0x96, 0x4f, 0x3d, 0xab, 0xd9,
+    0x9e, 0xec, 0x7a, 0x08, 0xd1, 0xa3, 0x35, 0x47,
+    0x00, 0xbb, 0xf1, 0x4a, 0x65, 0xde, 0x94, 0x2f,
+    0xca, 0x71, 0x3b, 0x80, 0xaf, 0x14, 0x5e, 0xe5,
+    0x00, 0xf8, 0x77, 0x8f, 0xee, 0x16, 0x99, 0x61,
+    0x5b, 0xa3, 0x2c, 0xd4, 0xb5, 0x4d, 0xc2, 0x3a,
+    0x00, 0xb6, 0xeb, 0x5d, 0x51, 0xe7, 0xba, 0x0c,
+    0xa2, 0x14, 0x49, 0xff, 0xf3, 0x45, 0x18, 0xae,
+    0x00, 0xe6, 0x4b, 0xad, 0x96, 0x70, 0xdd, 0x3b,
+    0xab, 0x4d, 0xe0, 0x06, 0x3d, 0xdb, 0x76, 0x90,
+    0x00, 0xd1, 0x25, 0xf4, 0x4a, 0x9b, 0x6f, 0xbe,
+    0x94, 0x45, 0xb1, 0x60, 0xde, 0x0f, 0xfb, 0x2a,
+    0x00, 0x42, 0x84, 0xc6, 0x8f, 0xcd, 0x0b, 0x49,
+    0x99, 0xdb, 0x1d, 0x5f, 0x16, 0x54, 0x92, 0xd0,
+    0x00, 0xb5, 0xed, 0x58, 0x5d, 0xe8, 0xb0, 0x05,
+    0xba, 0x0f, 0x57, 0xe2, 0xe7, 0x52, 0x0a, 0xbf,
+    0x00, 0x89, 0x95, 0x1c, 0xad, 0x24, 0x38, 0xb1,
+    0xdd, 0x54, 0x48, 0xc1, 0x70, 0xf9, 0xe5, 0x6c,
+    0x00, 0x3d, 0x7a, 0x47, 0xf4, 0xc9, 0x8e, 0xb3,
+    0x6f, 0x52, 0x15, 0x28, 0x9b, 0xa6, 0xe1, 0xdc,
+    0x00, 0xf2, 0x63, 0x91, 0xc6, 0x34, 0xa5, 0x57,
+    0x0b, 0xf9, 0x68, 0x9a, 0xcd, 0x3f, 0xae, 0x5c,
+    0x00, 0x16, 0x2c, 0x3a, 0x58, 0x4e, 0x74, 0x62,
+    0xb0, 0xa6, 0x9c, 0x8a, 0xe8, 0xfe, 0xc4, 0xd2,
+    0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15,
+    0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
+    0x00, 0x70, 0xe0, 0x90, 0x47, 0x37, 0xa7, 0xd7,
+    0x8e, 0xfe, 0x6e, 0x1e, 0xc9, 0xb9, 0x29, 0x59,
+    0x00, 0x86, 0x8b, 0x0d, 0x91, 0x17, 0x1a, 0x9c,
+    0xa5, 0x23, 0x2e, 0xa8, 0x34, 0xb2, 0xbf, 0x39,
+    0x00, 0xcd, 0x1d, 0xd0, 0x3a, 0xf7, 0x27, 0xea,
+    0x74, 0xb9, 0x69, 0xa4, 0x4e, 0x83, 0x53, 0x9e,
+    0x00, 0xa0, 0xc7, 0x67, 0x09, 0xa9, 0xce, 0x6e,
+    0x12, 0xb2, 0xd5, 0x75, 0x1b, 0xbb, 0xdc, 0x7c,
+    0x00, 0x24, 0x48, 0x6c, 0x90, 0xb4, 0xd8, 0xfc,
+    0xa7, 0x83, 0xef, 0xcb, 0x37, 0x13, 0x7f, 0x5b,
+    0x00, 0xa1, 0xc5, 0x64, 0x0d, 0xac, 0xc8, 0x69,
+    0x1a, 0xbb, 0xdf, 0x7e, 0x17, 0xb6, 0xd2, 0x73,
+    0x00, 0x34, 0x68, 0x5c, 0xd0, 0xe4, 0xb8, 0x8c,
+    0x27, 0x13, 0x4f, 0x7b, 0xf7, 0xc3, 0x9f, 0xab,
+    0x00, 0x78, 0xf0, 0x88, 0x67, 0x1f, 0x97, 0xef,
+    0xce, 0xb6, 0x3e, 0x46, 0xa9, 0xd1, 0x59, 0x21,
+    0x00, 0x1b, 0x36, 0x2d, 0x6c, 0x77, 0x5a, 0x41,
+    0xd8, 0xc3, 0xee, 0xf5, 0xb4, 0xaf, 0x82, 0x99,
+    0x00, 0x19, 0x32, 0x2b, 0x64, 0x7d, 0x56, 0x4f,
+    0xc8, 0xd1, 0xfa, 0xe3, 0xac, 0xb5, 0x9e, 0x87,
+    0x00, 0x17, 0x2e, 0x39, 0x5c, 0x4b, 0x72, 0x65,
+    0xb8, 0xaf, 0x96, 0x81, 0xe4, 0xf3, 0xca, 0xdd,
+    0x00, 0x22, 0x44, 0x66, 0x88, 0xaa, 0xcc, 0xee,
+    0x97, 0xb5, 0xd3, 0xf1, 0x1f, 0x3d, 0x5b, 0x79,
+    0x00, 0xa9, 0xd5, 0x7c, 0x2d, 0x84, 0xf8, 0x51,
+    0x5a, 0xf3, 0x8f, 0x26, 0x77, 0xde, 0xa2, 0x0b,
+    0x00, 0x6b, 0xd6, 0xbd, 0x2b, 0x40, 0xfd, 0x96,
+    0x56, 0x3d, 0x80, 0xeb, 0x7d, 0x16, 0xab, 0xc0,
+    0x00, 0xac, 0xdf, 0x73, 0x39, 0x95, 0xe6, 0x4a,
+    0x72, 0xde, 0xad, 0x01, 0x4b, 0xe7, 0x94, 0x38,
+    0x00, 0xda, 0x33, 0xe9, 0x66, 0xbc, 0x55, 0x8f,
+    0xcc, 0x16, 0xff, 0x25, 0xaa, 0x70, 0x99, 0x43,
+    0x00, 0x1f, 0x3e, 0x21, 0x7c, 0x63, 0x42, 0x5d,
+    0xf8, 0xe7, 0xc6, 0xd9, 0x84, 0x9b, 0xba, 0xa5,
+    0x00, 0x8d, 0x9d, 0x10, 0xbd, 0x30, 0x20, 0xad,
+    0xfd, 0x70, 0x60, 0xed, 0x40, 0xcd, 0xdd, 0x50,
+    0x00, 0x7d, 0xfa, 0x87, 0x73, 0x0e, 0x89, 0xf4,
+    0xe6, 0x9b, 0x1c, 0x61, 0x95, 0xe8, 0x6f, 0x12,
+    0x00, 0x98, 0xb7, 0x2f, 0xe9, 0x71, 0x5e, 0xc6,
+    0x55, 0xcd, 0xe2, 0x7a, 0xbc, 0x24, 0x0b, 0x93,
+    0x00, 0xaa, 0xd3, 0x79, 0x21, 0x8b, 0xf2, 0x58,
+    0x42, 0xe8, 0x91, 0x3b, 0x63, 0xc9, 0xb0, 0x1a,
+    0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c,
+    0x20, 0x24, 0x28, 0x2c, 0x30, 0x34, 0x38, 0x3c,
+    0x00, 0x40, 0x80, 0xc0, 0x87, 0xc7, 0x07, 0x47,
+    0x89, 0xc9, 0x09, 0x49, 0x0e, 0x4e, 0x8e, 0xce,
+    0x00, 0x6a, 0xd4, 0xbe, 0x2f, 0x45, 0xfb, 0x91,
+    0x5e, 0x34, 0x8a, 0xe0, 0x71, 0x1b, 0xa5, 0xcf,
+    0x00, 0xbc, 0xff, 0x43, 0x79, 0xc5, 0x86, 0x3a,
+    0xf2, 0x4e, 0x0d, 0xb1, 0x8b, 0x37, 0x74, 0xc8,
+};
+
+unsigned char CCSDS_chien_tab[] = {
+    0x00, 0x6f, 0xde, 0xb1, 0x3b, 0x54, 0xe5, 0x8a,
+    0x76, 0x19, 0xa8, 0xc7, 0x4d, 0x22, 0x93, 0xfc,
+    0x00, 0xec, 0x5f, 0xb3, 0xbe, 0x52, 0xe1, 0x0d,
+    0xfb, 0x17, 0xa4, 0x48, 0x45, 0xa9, 0x1a, 0xf6,
+    0x00, 0x1d, 0x3a, 0x27, 0x74, 0x69, 0x4e, 0x53,
+    0xe8, 0xf5, 0xd2, 0xcf, 0x9c, 0x81, 0xa6, 0xbb,
+    0x00, 0x57, 0xae, 0xf9, 0xdb, 0x8c, 0x75, 0x22,
+    0x31, 0x66, 0x9f, 0xc8, 0xea, 0xbd, 0x44, 0x13,
+    0x00, 0xce, 0x1b, 0xd5, 0x36, 0xf8, 0x2d, 0xe3,
+    0x6c, 0xa2, 0x77, 0xb9, 0x5a, 0x94, 0x41, 0x8f,
+    0x00, 0xd8, 0x37, 0xef, 0x6e, 0xb6, 0x59, 0x81,
+    0xdc, 0x04, 0xeb, 0x33, 0xb2, 0x6a, 0x85, 0x5d,
+    0x00, 0xd6, 0x2b, 0xfd, 0x56, 0x80, 0x7d, 0xab,
+    0xac, 0x7a, 0x87, 0x51, 0xfa, 0x2c, 0xd1, 0x07,
+    0x00, 0xdf, 0x39, 0xe6, 0x72, 0xad, 0x4b, 0x94,
+    0xe4, 0x3b, 0xdd, 0x02, 0x96, 0x49, 0xaf, 0x70,
+    0x00, 0x4c, 0x98, 0xd4, 0xb7, 0xfb, 0x2f, 0x63,
+    0xe9, 0xa5, 0x71, 0x3d, 0x5e, 0x12, 0xc6, 0x8a,
+    0x00, 0x55, 0xaa, 0xff, 0xd3, 0x86, 0x79, 0x2c,
+    0x21, 0x74, 0x8b, 0xde, 0xf2, 0xa7, 0x58, 0x0d,
+    0x00, 0xf3, 0x61, 0x92, 0xc2, 0x31, 0xa3, 0x50,
+    0x03, 0xf0, 0x62, 0x91, 0xc1, 0x32, 0xa0, 0x53,
+    0x00, 0x06, 0x0c, 0x0a, 0x18, 0x1e, 0x14, 0x12,
+    0x30, 0x36, 0x3c, 0x3a, 0x28, 0x2e, 0x24, 0x22,
+    0x00, 0x47, 0x8e, 0xc9, 0x9b, 0xdc, 0x15, 0x52,
+    0xb1, 0xf6, 0x3f, 0x78, 0x2a, 0x6d, 0xa4, 0xe3,
+    0x00, 0xe5, 0x4d, 0xa8, 0x9a, 0x7f, 0xd7, 0x32,
+    0xb3, 0x56, 0xfe, 0x1b, 0x29, 0xcc, 0x64, 0x81,
+    0x00, 0x34, 0x68, 0x5c, 0xd0, 0xe4, 0xb8, 0x8c,
+    0x27, 0x13, 0x4f, 0x7b, 0xf7, 0xc3, 0x9f, 0xab,
+    0x00, 0x4e, 0x9c, 0xd2, 0xbf, 0xf1, 0x23, 0x6d,
+    0xf9, 0xb7, 0x65, 0x2b, 0x46, 0x08, 0xda, 0x94,
+    0x00, 0x88, 0x97, 0x1f, 0xa9, 0x21, 0x3e, 0xb6,
+    0xd5, 0x5d, 0x42, 0xca, 0x7c, 0xf4, 0xeb, 0x63,
+    0x00, 0x2d, 0x5a, 0x77, 0xb4, 0x99, 0xee, 0xc3,
+    0xef, 0xc2, 0xb5, 0x98, 0x5b, 0x76, 0x01, 0x2c,
+    0x00, 0x8d, 0x9d, 0x10, 0xbd, 0x30, 0x20, 0xad,
+    0xfd, 0x70, 0x60, 0xed, 0x40, 0xcd, 0xdd, 0x50,
+    0x00, 0x7d, 0xfa, 0x87, 0x73, 0x0e, 0x89, 0xf4,
+    0xe6, 0x9b, 0x1c, 0x61, 0x95, 0xe8, 0x6f, 0x12,
+    0x00, 0xd9, 0x35, 0xec, 0x6a, 0xb3, 0x5f, 0x86,
+    0xd4, 0x0d, 0xe1, 0x38, 0xbe, 0x67, 0x8b, 0x52,
+    0x00, 0x2f, 0x5e, 0x71, 0xbc, 0x93, 0xe2, 0xcd,
+    0xff, 0xd0, 0xa1, 0x8e, 0x43, 0x6c, 0x1d, 0x32,
+    0x00, 0xb0, 0xe7, 0x57, 0x49, 0xf9, 0xae, 0x1e,
+    0x92, 0x22, 0x75, 0xc5, 0xdb, 0x6b, 0x3c, 0x8c,
+    0x00, 0xa3, 0xc1, 0x62, 0x05, 0xa6, 0xc4, 0x67,
+    0x0a, 0xa9, 0xcb, 0x68, 0x0f, 0xac, 0xce, 0x6d,
+    0x00, 0x48, 0x90, 0xd8, 0xa7, 0xef, 0x37, 0x7f,
+    0xc9, 0x81, 0x59, 0x11, 0x6e, 0x26, 0xfe, 0xb6,
+    0x00, 0x15, 0x2a, 0x3f, 0x54, 0x41, 0x7e, 0x6b,
+    0xa8, 0xbd, 0x82, 0x97, 0xfc, 0xe9, 0xd6, 0xc3,
+    0x00, 0xc8, 0x17, 0xdf, 0x2e, 0xe6, 0x39, 0xf1,
+    0x5c, 0x94, 0x4b, 0x83, 0x72, 0xba, 0x65, 0xad,
+    0x00, 0xb8, 0xf7, 0x4f, 0x69, 0xd1, 0x9e, 0x26,
+    0xd2, 0x6a, 0x25, 0x9d, 0xbb, 0x03, 0x4c, 0xf4,
+    0x00, 0x33, 0x66, 0x55, 0xcc, 0xff, 0xaa, 0x99,
+    0x1f, 0x2c, 0x79, 0x4a, 0xd3, 0xe0, 0xb5, 0x86,
+    0x00, 0x3e, 0x7c, 0x42, 0xf8, 0xc6, 0x84, 0xba,
+    0x77, 0x49, 0x0b, 0x35, 0x8f, 0xb1, 0xf3, 0xcd,
+    0x00, 0x02, 0x04, 0x06, 0x08, 0x0a, 0x0c, 0x0e,
+    0x10, 0x12, 0x14, 0x16, 0x18, 0x1a, 0x1c, 0x1e,
+    0x00, 0x20, 0x40, 0x60, 0x80, 0xa0, 0xc0, 0xe0,
+    0x87, 0xa7, 0xc7, 0xe7, 0x07, 0x27, 0x47, 0x67,
+    0x00, 0xde, 0x3b, 0xe5, 0x76, 0xa8, 0x4d, 0x93,
+    0xec, 0x32, 0xd7, 0x09, 0x9a, 0x44, 0xa1, 0x7f,
+    0x00, 0x5f, 0xbe, 0xe1, 0xfb, 0xa4, 0x45, 0x1a,
+    0x71, 0x2e, 0xcf, 0x90, 0x8a, 0xd5, 0x34, 0x6b,
+    0x00, 0x3a, 0x74, 0x4e, 0xe8, 0xd2, 0x9c, 0xa6,
+    0x57, 0x6d, 0x23, 0x19, 0xbf, 0x85, 0xcb, 0xf1,
+    0x00, 0xae, 0xdb, 0x75, 0x31, 0x9f, 0xea, 0x44,
+    0x62, 0xcc, 0xb9, 0x17, 0x53, 0xfd, 0x88, 0x26,
+    0x00, 0x1b, 0x36, 0x2d, 0x6c, 0x77, 0x5a, 0x41,
+    0xd8, 0xc3, 0xee, 0xf5, 0xb4, 0xaf, 0x82, 0x99,
+    0x00, 0x37, 0x6e, 0x59, 0xdc, 0xeb, 0xb2, 0x85,
+    0x3f, 0x08, 0x51, 0x66, 0xe3, 0xd4, 0x8d, 0xba,
+    0x00, 0x2b, 0x56, 0x7d, 0xac, 0x87, 0xfa, 0xd1,
+    0xdf, 0xf4, 0x89, 0xa2, 0x73, 0x58, 0x25, 0x0e,
+    0x00, 0x39, 0x72, 0x4b, 0xe4, 0xdd, 0x96, 0xaf,
+    0x4f, 0x76, 0x3d, 0x04, 0xab, 0x92, 0xd9, 0xe0,
+    0x00, 0x98, 0xb7, 0x2f, 0xe9, 0x71, 0x5e, 0xc6,
+    0x55, 0xcd, 0xe2, 0x7a, 0xbc, 0x24, 0x0b, 0x93,
+    0x00, 0xaa, 0xd3, 0x79, 0x21, 0x8b, 0xf2, 0x58,
+    0x42, 0xe8, 0x91, 0x3b, 0x63, 0xc9, 0xb0, 0x1a,
+    0x00, 0x61, 0xc2, 0xa3, 0x03, 0x62, 0xc1, 0xa0,
+    0x06, 0x67, 0xc4, 0xa5, 0x05, 0x64, 0xc7, 0xa6,
+    0x00, 0x0c, 0x18, 0x14, 0x30, 0x3c, 0x28, 0x24,
+    0x60, 0x6c, 0x78, 0x74, 0x50, 0x5c, 0x48, 0x44,
+    0x00, 0x8e, 0x9b, 0x15, 0xb1, 0x3f, 0x2a, 0xa4,
+    0xe5, 0x6b, 0x7e, 0xf0, 0x54, 0xda, 0xcf, 0x41,
+    0x00, 0x4d, 0x9a, 0xd7, 0xb3, 0xfe, 0x29, 0x64,
+    0xe1, 0xac, 0x7b, 0x36, 0x52, 0x1f, 0xc8, 0x85,
+    0x00, 0x68, 0xd0, 0xb8, 0x27, 0x4f, 0xf7, 0x9f,
+    0x4e, 0x26, 0x9e, 0xf6, 0x69, 0x01, 0xb9, 0xd1,
+    0x00, 0x9c, 0xbf, 0x23, 0xf9, 0x65, 0x46, 0xda,
+    0x75, 0xe9, 0xca, 0x56, 0x8c, 0x10, 0x33, 0xaf,
+    0x00, 0x97, 0xa9, 0x3e, 0xd5, 0x42, 0x7c, 0xeb,
+    0x2d, 0xba, 0x84, 0x13, 0xf8, 0x6f, 0x51, 0xc6,
+    0x00, 0x5a, 0xb4, 0xee, 0xef, 0xb5, 0x5b, 0x01,
+    0x59, 0x03, 0xed, 0xb7, 0xb6, 0xec, 0x02, 0x58,
+    0x00, 0x9d, 0xbd, 0x20, 0xfd, 0x60, 0x40, 0xdd,
+    0x7d, 0xe0, 0xc0, 0x5d, 0x80, 0x1d, 0x3d, 0xa0,
+    0x00, 0xfa, 0x73, 0x89, 0xe6, 0x1c, 0x95, 0x6f,
+    0x4b, 0xb1, 0x38, 0xc2, 0xad, 0x57, 0xde, 0x24,
+    0x00, 0x35, 0x6a, 0x5f, 0xd4, 0xe1, 0xbe, 0x8b,
+    0x2f, 0x1a, 0x45, 0x70, 0xfb, 0xce, 0x91, 0xa4,
+    0x00, 0x5e, 0xbc, 0xe2, 0xff, 0xa1, 0x43, 0x1d,
+    0x79, 0x27, 0xc5, 0x9b, 0x86, 0xd8, 0x3a, 0x64,
+    0x00, 0xe7, 0x49, 0xae, 0x92, 0x75, 0xdb, 0x3c,
+    0xa3, 0x44, 0xea, 0x0d, 0x31, 0xd6, 0x78, 0x9f,
+    0x00, 0xc1, 0x05, 0xc4, 0x0a, 0xcb, 0x0f, 0xce,
+    0x14, 0xd5, 0x11, 0xd0, 0x1e, 0xdf, 0x1b, 0xda,
+    0x00, 0x90, 0xa7, 0x37, 0xc9, 0x59, 0x6e, 0xfe,
+    0x15, 0x85, 0xb2, 0x22, 0xdc, 0x4c, 0x7b, 0xeb,
+    0x00, 0x2a, 0x54, 0x7e, 0xa8, 0x82, 0xfc, 0xd6,
+    0xd7, 0xfd, 0x83, 0xa9, 0x7f, 0x55, 0x2b, 0x01,
+    0x00, 0x17, 0x2e, 0x39, 0x5c, 0x4b, 0x72, 0x65,
+    0xb8, 0xaf, 0x96, 0x81, 0xe4, 0xf3, 0xca, 0xdd,
+    0x00, 0xf7, 0x69, 0x9e, 0xd2, 0x25, 0xbb, 0x4c,
+    0x23, 0xd4, 0x4a, 0xbd, 0xf1, 0x06, 0x98, 0x6f,
+    0x00, 0x66, 0xcc, 0xaa, 0x1f, 0x79, 0xd3, 0xb5,
+    0x3e, 0x58, 0xf2, 0x94, 0x21, 0x47, 0xed, 0x8b,
+    0x00, 0x7c, 0xf8, 0x84, 0x77, 0x0b, 0x8f, 0xf3,
+    0xee, 0x92, 0x16, 0x6a, 0x99, 0xe5, 0x61, 0x1d,
+    0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c,
+    0x20, 0x24, 0x28, 0x2c, 0x30, 0x34, 0x38, 0x3c,
+    0x00, 0x40, 0x80, 0xc0, 0x87, 0xc7, 0x07, 0x47,
+    0x89, 0xc9, 0x09, 0x49, 0x0e, 0x4e, 0x8e, 0xce,
+};
+
+unsigned char CCSDS_encode_tab[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x5b, 0x7f, 0x56, 0x10, 0x1e, 0x0d, 0xeb, 0x61,
+    0xa5, 0x08, 0x2a, 0x36, 0x56, 0xab, 0x20, 0x71,
+    0x20, 0xab, 0x56, 0x36, 0x2a, 0x08, 0xa5, 0x61,
+    0xeb, 0x0d, 0x1e, 0x10, 0x56, 0x7f, 0x5b, 0x01,
+    0xb6, 0xfe, 0xac, 0x20, 0x3c, 0x1a, 0x51, 0xc2,
+    0xcd, 0x10, 0x54, 0x6c, 0xac, 0xd1, 0x40, 0xe2,
+    0x40, 0xd1, 0xac, 0x6c, 0x54, 0x10, 0xcd, 0xc2,
+    0x51, 0x1a, 0x3c, 0x20, 0xac, 0xfe, 0xb6, 0x02,
+    0xed, 0x81, 0xfa, 0x30, 0x22, 0x17, 0xba, 0xa3,
+    0x68, 0x18, 0x7e, 0x5a, 0xfa, 0x7a, 0x60, 0x93,
+    0x60, 0x7a, 0xfa, 0x5a, 0x7e, 0x18, 0x68, 0xa3,
+    0xba, 0x17, 0x22, 0x30, 0xfa, 0x81, 0xed, 0x03,
+    0xeb, 0x7b, 0xdf, 0x40, 0x78, 0x34, 0xa2, 0x03,
+    0x1d, 0x20, 0xa8, 0xd8, 0xdf, 0x25, 0x80, 0x43,
+    0x80, 0x25, 0xdf, 0xd8, 0xa8, 0x20, 0x1d, 0x03,
+    0xa2, 0x34, 0x78, 0x40, 0xdf, 0x7b, 0xeb, 0x04,
+    0xb0, 0x04, 0x89, 0x50, 0x66, 0x39, 0x49, 0x62,
+    0xb8, 0x28, 0x82, 0xee, 0x89, 0x8e, 0xa0, 0x32,
+    0xa0, 0x8e, 0x89, 0xee, 0x82, 0x28, 0xb8, 0x62,
+    0x49, 0x39, 0x66, 0x50, 0x89, 0x04, 0xb0, 0x05,
+    0x5d, 0x85, 0x73, 0x60, 0x44, 0x2e, 0xf3, 0xc1,
+    0xd0, 0x30, 0xfc, 0xb4, 0x73, 0xf4, 0xc0, 0xa1,
+    0xc0, 0xf4, 0x73, 0xb4, 0xfc, 0x30, 0xd0, 0xc1,
+    0xf3, 0x2e, 0x44, 0x60, 0x73, 0x85, 0x5d, 0x06,
+    0x06, 0xfa, 0x25, 0x70, 0x5a, 0x23, 0x18, 0xa0,
+    0x75, 0x38, 0xd6, 0x82, 0x25, 0x5f, 0xe0, 0xd0,
+    0xe0, 0x5f, 0x25, 0x82, 0xd6, 0x38, 0x75, 0xa0,
+    0x18, 0x23, 0x5a, 0x70, 0x25, 0xfa, 0x06, 0x07,
+    0x51, 0xf6, 0x39, 0x80, 0xf0, 0x68, 0xc3, 0x06,
+    0x3a, 0x40, 0xd7, 0x37, 0x39, 0x4a, 0x87, 0x86,
+    0x87, 0x4a, 0x39, 0x37, 0xd7, 0x40, 0x3a, 0x06,
+    0xc3, 0x68, 0xf0, 0x80, 0x39, 0xf6, 0x51, 0x08,
+    0x0a, 0x89, 0x6f, 0x90, 0xee, 0x65, 0x28, 0x67,
+    0x9f, 0x48, 0xfd, 0x01, 0x6f, 0xe1, 0xa7, 0xf7,
+    0xa7, 0xe1, 0x6f, 0x01, 0xfd, 0x48, 0x9f, 0x67,
+    0x28, 0x65, 0xee, 0x90, 0x6f, 0x89, 0x0a, 0x09,
+    0xe7, 0x08, 0x95, 0xa0, 0xcc, 0x72, 0x92, 0xc4,
+    0xf7, 0x50, 0x83, 0x5b, 0x95, 0x9b, 0xc7, 0x64,
+    0xc7, 0x9b, 0x95, 0x5b, 0x83, 0x50, 0xf7, 0xc4,
+    0x92, 0x72, 0xcc, 0xa0, 0x95, 0x08, 0xe7, 0x0a,
+    0xbc, 0x77, 0xc3, 0xb0, 0xd2, 0x7f, 0x79, 0xa5,
+    0x52, 0x58, 0xa9, 0x6d, 0xc3, 0x30, 0xe7, 0x15,
+    0xe7, 0x30, 0xc3, 0x6d, 0xa9, 0x58, 0x52, 0xa5,
+    0x79, 0x7f, 0xd2, 0xb0, 0xc3, 0x77, 0xbc, 0x0b,
+    0xba, 0x8d, 0xe6, 0xc0, 0x88, 0x5c, 0x61, 0x05,
+    0x27, 0x60, 0x7f, 0xef, 0xe6, 0x6f, 0x07, 0xc5,
+    0x07, 0x6f, 0xe6, 0xef, 0x7f, 0x60, 0x27, 0x05,
+    0x61, 0x5c, 0x88, 0xc0, 0xe6, 0x8d, 0xba, 0x0c,
+    0xe1, 0xf2, 0xb0, 0xd0, 0x96, 0x51, 0x8a, 0x64,
+    0x82, 0x68, 0x55, 0xd9, 0xb0, 0xc4, 0x27, 0xb4,
+    0x27, 0xc4, 0xb0, 0xd9, 0x55, 0x68, 0x82, 0x64,
+    0x8a, 0x51, 0x96, 0xd0, 0xb0, 0xf2, 0xe1, 0x0d,
+    0x0c, 0x73, 0x4a, 0xe0, 0xb4, 0x46, 0x30, 0xc7,
+    0xea, 0x70, 0x2b, 0x83, 0x4a, 0xbe, 0x47, 0x27,
+    0x47, 0xbe, 0x4a, 0x83, 0x2b, 0x70, 0xea, 0xc7,
+    0x30, 0x46, 0xb4, 0xe0, 0x4a, 0x73, 0x0c, 0x0e,
+    0x57, 0x0c, 0x1c, 0xf0, 0xaa, 0x4b, 0xdb, 0xa6,
+    0x4f, 0x78, 0x01, 0xb5, 0x1c, 0x15, 0x67, 0x56,
+    0x67, 0x15, 0x1c, 0xb5, 0x01, 0x78, 0x4f, 0xa6,
+    0xdb, 0x4b, 0xaa, 0xf0, 0x1c, 0x0c, 0x57, 0x0f,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xa2, 0x6b, 0x72, 0x87, 0x67, 0xd0, 0x01, 0x0c,
+    0x74, 0x80, 0x29, 0x6e, 0x72, 0x94, 0x89, 0x8b,
+    0x89, 0x94, 0x72, 0x6e, 0x29, 0x80, 0x74, 0x0c,
+    0x01, 0xd0, 0x67, 0x87, 0x72, 0x6b, 0xa2, 0x10,
+    0xc3, 0xd6, 0xe4, 0x89, 0xce, 0x27, 0x02, 0x18,
+    0xe8, 0x87, 0x52, 0xdc, 0xe4, 0xaf, 0x95, 0x91,
+    0x95, 0xaf, 0xe4, 0xdc, 0x52, 0x87, 0xe8, 0x18,
+    0x02, 0x27, 0xce, 0x89, 0xe4, 0xd6, 0xc3, 0x20,
+    0x61, 0xbd, 0x96, 0x0e, 0xa9, 0xf7, 0x03, 0x14,
+    0x9c, 0x07, 0x7b, 0xb2, 0x96, 0x3b, 0x1c, 0x1a,
+    0x1c, 0x3b, 0x96, 0xb2, 0x7b, 0x07, 0x9c, 0x14,
+    0x03, 0xf7, 0xa9, 0x0e, 0x96, 0xbd, 0x61, 0x30,
+    0x01, 0x2b, 0x4f, 0x95, 0x1b, 0x4e, 0x04, 0x30,
+    0x57, 0x89, 0xa4, 0x3f, 0x4f, 0xd9, 0xad, 0xa5,
+    0xad, 0xd9, 0x4f, 0x3f, 0xa4, 0x89, 0x57, 0x30,
+    0x04, 0x4e, 0x1b, 0x95, 0x4f, 0x2b, 0x01, 0x40,
+    0xa3, 0x40, 0x3d, 0x12, 0x7c, 0x9e, 0x05, 0x3c,
+    0x23, 0x09, 0x8d, 0x51, 0x3d, 0x4d, 0x24, 0x2e,
+    0x24, 0x4d, 0x3d, 0x51, 0x8d, 0x09, 0x23, 0x3c,
+    0x05, 0x9e, 0x7c, 0x12, 0x3d, 0x40, 0xa3, 0x50,
+    0xc2, 0xfd, 0xab, 0x1c, 0xd5, 0x69, 0x06, 0x28,
+    0xbf, 0x0e, 0xf6, 0xe3, 0xab, 0x76, 0x38, 0x34,
+    0x38, 0x76, 0xab, 0xe3, 0xf6, 0x0e, 0xbf, 0x28,
+    0x06, 0x69, 0xd5, 0x1c, 0xab, 0xfd, 0xc2, 0x60,
+    0x60, 0x96, 0xd9, 0x9b, 0xb2, 0xb9, 0x07, 0x24,
+    0xcb, 0x8e, 0xdf, 0x8d, 0xd9, 0xe2, 0xb1, 0xbf,
+    0xb1, 0xe2, 0xd9, 0x8d, 0xdf, 0x8e, 0xcb, 0x24,
+    0x07, 0xb9, 0xb2, 0x9b, 0xd9, 0x96, 0x60, 0x70,
+    0x02, 0x56, 0x9e, 0xad, 0x36, 0x9c, 0x08, 0x60,
+    0xae, 0x95, 0xcf, 0x7e, 0x9e, 0x35, 0xdd, 0xcd,
+    0xdd, 0x35, 0x9e, 0x7e, 0xcf, 0x95, 0xae, 0x60,
+    0x08, 0x9c, 0x36, 0xad, 0x9e, 0x56, 0x02, 0x80,
+    0xa0, 0x3d, 0xec, 0x2a, 0x51, 0x4c, 0x09, 0x6c,
+    0xda, 0x15, 0xe6, 0x10, 0xec, 0xa1, 0x54, 0x46,
+    0x54, 0xa1, 0xec, 0x10, 0xe6, 0x15, 0xda, 0x6c,
+    0x09, 0x4c, 0x51, 0x2a, 0xec, 0x3d, 0xa0, 0x90,
+    0xc1, 0x80, 0x7a, 0x24, 0xf8, 0xbb, 0x0a, 0x78,
+    0x46, 0x12, 0x9d, 0xa2, 0x7a, 0x9a, 0x48, 0x5c,
+    0x48, 0x9a, 0x7a, 0xa2, 0x9d, 0x12, 0x46, 0x78,
+    0x0a, 0xbb, 0xf8, 0x24, 0x7a, 0x80, 0xc1, 0xa0,
+    0x63, 0xeb, 0x08, 0xa3, 0x9f, 0x6b, 0x0b, 0x74,
+    0x32, 0x92, 0xb4, 0xcc, 0x08, 0x0e, 0xc1, 0xd7,
+    0xc1, 0x0e, 0x08, 0xcc, 0xb4, 0x92, 0x32, 0x74,
+    0x0b, 0x6b, 0x9f, 0xa3, 0x08, 0xeb, 0x63, 0xb0,
+    0x03, 0x7d, 0xd1, 0x38, 0x2d, 0xd2, 0x0c, 0x50,
+    0xf9, 0x1c, 0x6b, 0x41, 0xd1, 0xec, 0x70, 0x68,
+    0x70, 0xec, 0xd1, 0x41, 0x6b, 0x1c, 0xf9, 0x50,
+    0x0c, 0xd2, 0x2d, 0x38, 0xd1, 0x7d, 0x03, 0xc0,
+    0xa1, 0x16, 0xa3, 0xbf, 0x4a, 0x02, 0x0d, 0x5c,
+    0x8d, 0x9c, 0x42, 0x2f, 0xa3, 0x78, 0xf9, 0xe3,
+    0xf9, 0x78, 0xa3, 0x2f, 0x42, 0x9c, 0x8d, 0x5c,
+    0x0d, 0x02, 0x4a, 0xbf, 0xa3, 0x16, 0xa1, 0xd0,
+    0xc0, 0xab, 0x35, 0xb1, 0xe3, 0xf5, 0x0e, 0x48,
+    0x11, 0x9b, 0x39, 0x9d, 0x35, 0x43, 0xe5, 0xf9,
+    0xe5, 0x43, 0x35, 0x9d, 0x39, 0x9b, 0x11, 0x48,
+    0x0e, 0xf5, 0xe3, 0xb1, 0x35, 0xab, 0xc0, 0xe0,
+    0x62, 0xc0, 0x47, 0x36, 0x84, 0x25, 0x0f, 0x44,
+    0x65, 0x1b, 0x10, 0xf3, 0x47, 0xd7, 0x6c, 0x72,
+    0x6c, 0xd7, 0x47, 0xf3, 0x10, 0x1b, 0x65, 0x44,
+    0x0f, 0x25, 0x84, 0x36, 0x47, 0xc0, 0x62, 0xf0,
+};
@@ -18,6 +18,8 @@
  * FCR - An integer literal or variable specifying the first consecutive root of the
  *       Reed-Solomon generator polynomial. Integer variable or literal.
  * PRIM - The primitive root of the generator poly. Integer variable or literal.
+ * RS_SIMD - The address of a struct rs_simd with the tables for the code, used
+ *           to compute the syndromes and do the Chien search. See rs_simd.h.
  * DEBUG - If set to 1 or more, do various internal consistency checking. Leave this
  *         undefined for production code
 
@@ -59,6 +61,10 @@
 #error "PRIM not defined"
 #endif
 
+#if !defined(RS_SIMD)
+#error "RS_SIMD not defined"
+#endif
+
 #if !defined(NULL)
 #define NULL ((void*)0)
 #endif
@@ -70,39 +76,30 @@
 
 {
     int deg_lambda, el, deg_omega;
-    int i, j, r, k;
-    data_t u, q, tmp, num1, num2, den, discr_r;
+    int i, j, r;
+    data_t u, tmp, num1, num2, den, discr_r;
 #ifdef MAX_ARRAY
     data_t lambda[MAX_ARRAY], s[MAX_ARRAY]; /* Err+Eras Locator poly
                                              * and syndrome poly */
     data_t b[MAX_ARRAY], t[MAX_ARRAY], omega[MAX_ARRAY];
-    data_t root[MAX_ARRAY], reg[MAX_ARRAY], loc[MAX_ARRAY];
+    data_t root[MAX_ARRAY], loc[MAX_ARRAY];
 #else  /* MAX_ARRAY */
     data_t lambda[NROOTS + 1], s[NROOTS]; /* Err+Eras Locator poly
                                            * and syndrome poly */
     data_t b[NROOTS + 1], t[NROOTS + 1], omega[NROOTS + 1];
-    data_t root[NROOTS], reg[NROOTS + 1], loc[NROOTS];
+    data_t root[NROOTS], loc[NROOTS];
 #endif /* MAX_ARRAY */
+#if DEBUG >= 1
+    data_t q, reg[NROOTS + 1];
+    int k;
+#endif
     int syn_error, count;
 
     /* form the syndromes; i.e., evaluate data(x) at roots of g(x) */
-    for (i = 0; i < NROOTS; i++)
-        s[i] = data[0];
-
-    for (j = 1; j < NN - PAD; j++) {
-        for (i = 0; i < NROOTS; i++) {
-            if (s[i] == 0) {
-                s[i] = data[j];
-            } else {
-                s[i] = data[j] ^ ALPHA_TO[MODNN(INDEX_OF[s[i]] + (FCR + i) * PRIM)];
-            }
-        }
-    }
+    syn_error = rs_simd_syndromes(RS_SIMD, data, NN - PAD, s);
 
-    /* Convert syndromes to index form, checking for nonzero condition */
-    syn_error = 0;
+    /* Convert syndromes to index form */
     for (i = 0; i < NROOTS; i++) {
-        syn_error |= s[i];
         s[i] = INDEX_OF[s[i]];
     }
 
@@ -221,29 +218,13 @@
             deg_lambda = i;
     }
     /* Find roots of the error+erasure locator polynomial by Chien search */
-    memcpy(&reg[1], &lambda[1], NROOTS * sizeof(reg[0]));
-    count = 0; /* Number of roots of lambda(x) */
-    for (i = 1, k = IPRIM - 1; i <= NN; i++, k = MODNN(k + IPRIM)) {
-        q = 1; /* lambda[0] is always 0 */
-        for (j = deg_lambda; j > 0; j--) {
-            if (reg[j] != A0) {
-                reg[j] = MODNN(reg[j] + j);
-                q ^= ALPHA_TO[reg[j]];
-            }
-        }
-        if (q != 0)
-            continue; /* Not a root */
-                      /* store root (index-form) and error location number */
+    count = rs_simd_chien(RS_SIMD, lambda, deg_lambda, root);
+    /* store error location numbers */
+    for (i = 0; i < count; i++) {
+        loc[i] = MODNN(root[i] * IPRIM + NN - 1);
 #if DEBUG >= 2
-        printf("count %d root %d loc %d\n", count, i, k);
+        printf("count %d root %d loc %d\n", i, root[i], loc[i]);
 #endif
-        root[count] = i;
-        loc[count] = k;
-        /* If we've already found max possible roots,
-         * abort the search to save time
-         */
-        if (++count == deg_lambda)
-            break;
     }
     if (deg_lambda != count) {
         /*
@@ -10,6 +10,35 @@
 #include <string.h>
 
 #include "fixed.h"
+#include "rs_simd.h"
+
+static struct rs_simd ccsds_simd = {
+    NN, NROOTS, FCR, PRIM, CCSDS_alpha_to, CCSDS_index_of, CCSDS_syndrome_tab,
+    CCSDS_chien_tab, CCSDS_encode_tab, NULL, NULL, NULL,
+};
+
+/* The kernels are selected when the library is loaded, before any decoder
+ * runs. Compilers without constructors have no runtime CPU dispatch, so
+ * they select the kernels on the first call, always with the same result.
+ */
+#ifdef __GNUC__
+__attribute__((constructor))
+#endif
+static void select_ccsds_kernels(void)
+{
+    rs_simd_select_kernels(&ccsds_simd);
+}
+
+const struct rs_simd* rs_simd_ccsds(void)
+{
+#ifndef __GNUC__
+    if (ccsds_simd.chien == NULL) {
+        select_ccsds_kernels();
+    }
+#endif
+    return &ccsds_simd;
+}
+#define RS_SIMD rs_simd_ccsds()
 
 int decode_rs_8(data_t* data, int* eras_pos, int no_eras, int pad)
 {
@@ -17,6 +17,7 @@ int decode_rs_char(void* p, data_t* data, int* eras_pos, int no_eras)
     int retval;
     struct rs* rs = (struct rs*)p;
 
+#define RS_SIMD (&rs->simd)
 #include "decode_rs.h"
 
     return retval;
@@ -22,6 +22,11 @@ int decode_rs_8(unsigned char* data, int* eras_pos, int no_eras, int pad);
 void encode_rs_ccsds(unsigned char* data, unsigned char* parity, int pad);
 int decode_rs_ccsds(unsigned char* data, int* eras_pos, int no_eras, int pad);
 
+/* SIMD tables of the general purpose and CCSDS codecs (see rs_simd.h) */
+struct rs_simd;
+const struct rs_simd* rs_simd_char(void* rs);
+const struct rs_simd* rs_simd_ccsds(void);
+
 /* Tables to map from conventional->dual (Taltab) and
  * dual->conventional (Tal1tab) bases
  */
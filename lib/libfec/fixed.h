@@ -20,6 +20,9 @@ static inline int mod255(int x)
 extern data_t CCSDS_alpha_to[];
 extern data_t CCSDS_index_of[];
 extern data_t CCSDS_poly[];
+extern data_t CCSDS_syndrome_tab[];
+extern data_t CCSDS_chien_tab[];
+extern data_t CCSDS_encode_tab[];
 
 #define MM 8
 #define NN 255
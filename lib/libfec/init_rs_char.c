@@ -15,9 +15,17 @@ void free_rs_char(void* p)
     free(rs->alpha_to);
     free(rs->index_of);
     free(rs->genpoly);
+    free(rs->simd_tab);
     free(rs);
 }
 
+const struct rs_simd* rs_simd_char(void* p)
+{
+    struct rs* rs = (struct rs*)p;
+
+    return &rs->simd;
+}
+
 /* Initialize a Reed-Solomon codec
  * symsize = symbol size, bits
  * gfpoly = Field generator polynomial coefficients
@@ -32,5 +40,39 @@ void* init_rs_char(int symsize, int gfpoly, int fcr, int prim, int nroots, int p
 
 #include "init_rs.h"
 
+    if (rs == NULL)
+        return NULL;
+
+    rs->simd_tab = (unsigned char*)malloc(2 * 32 * nroots +
+                                          32 * RS_SIMD_ENCODE_STRIDE(nroots) + 1);
+    if (rs->simd_tab == NULL) {
+        free_rs_char(rs);
+        return NULL;
+    }
+    rs_simd_init_tables(rs->simd_tab,
+                        &rs->simd_tab[32 * nroots],
+                        rs->alpha_to,
+                        rs->index_of,
+                        rs->nn,
+                        fcr,
+                        prim,
+                        nroots);
+    rs_simd_encode_table(&rs->simd_tab[2 * 32 * nroots],
+                         rs->genpoly,
+                         rs->alpha_to,
+                         rs->index_of,
+                         rs->nn,
+                         nroots);
+    rs->simd.nn = rs->nn;
+    rs->simd.nroots = nroots;
+    rs->simd.fcr = fcr;
+    rs->simd.prim = prim;
+    rs->simd.alpha_to = rs->alpha_to;
+    rs->simd.index_of = rs->index_of;
+    rs->simd.syndrome_tab = rs->simd_tab;
+    rs->simd.chien_tab = &rs->simd_tab[32 * nroots];
+    rs->simd.encode_tab = &rs->simd_tab[2 * 32 * nroots];
+    rs_simd_select_kernels(&rs->simd);
+
     return rs;
 }
@@ -3,6 +3,8 @@
  * May be used under the terms of the GNU Lesser General Public License (LGPL)
  */
 
+#include "rs_simd.h"
+
 /* Reed-Solomon codec control block */
 struct rs {
     int mm;           /* Bits per symbol */
@@ -15,6 +17,9 @@ struct rs {
     int prim;         /* Primitive element, index form */
     int iprim;        /* prim-th root of 1, index form */
     int pad;          /* Padding bytes in shortened block */
+    /* Tables for the SIMD encoder and decoder, owned by simd_tab */
+    struct rs_simd simd;
+    unsigned char* simd_tab;
 };
 
 static inline int modnn(struct rs* rs, int x)
@@ -0,0 +1,834 @@
+/* SIMD encoding, syndrome computation and Chien search for Reed-Solomon
+ * codes with symbols of up to 8 bits
+ *
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ * May be used under the terms of the GNU Lesser General Public License (LGPL)
+ */
+#include <string.h>
+
+#include "rs_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define RS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/* Number of symbols processed at once by the SIMD kernels */
+#define LANES 16
+
+/* Maximum number of terms of the error locator polynomial */
+#define MAX_TERMS 255
+
+/* Maximum number of parity symbols in the vector registers of the encoder */
+#define MAX_ENCODE_ROOTS 32
+
+/* Maximum number of symbols in a chunk of the syndrome kernels,
+ * lcm(LANES, interleave)
+ */
+#define MAX_CHUNK (LANES * RS_SIMD_MAX_INTERLEAVE)
+
+static inline int add_mod(int a, int b, int nn)
+{
+    a += b;
+    return a >= nn ? a - nn : a;
+}
+
+/* Index form of the root used for syndrome i */
+static inline int syndrome_log(const struct rs_simd* rs, int i)
+{
+    return ((rs->fcr + i) * rs->prim) % rs->nn;
+}
+
+static int gcd(int a, int b)
+{
+    while (b) {
+        const int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* The syndrome kernels process the interleaved codewords in chunks of
+ * lcm(LANES, interleave) symbols. Each lane always holds symbols of the
+ * same codeword, and advances chunk / interleave symbols of that codeword
+ * in each chunk.
+ */
+static inline int chunk_size(int interleave)
+{
+    return LANES / gcd(LANES, interleave) * interleave;
+}
+
+void rs_simd_mul_table(unsigned char* tab,
+                       int log_c,
+                       const unsigned char* alpha_to,
+                       const unsigned char* index_of,
+                       int nn)
+{
+    int x, y;
+
+    for (x = 0; x < 16; x++) {
+        y = x;
+        tab[x] = (y == 0 || y > nn) ? 0 : alpha_to[(index_of[y] + log_c) % nn];
+        y = x << 4;
+        tab[16 + x] = (y == 0 || y > nn) ? 0 : alpha_to[(index_of[y] + log_c) % nn];
+    }
+}
+
+void rs_simd_init_tables(unsigned char* syndrome_tab,
+                         unsigned char* chien_tab,
+                         const unsigned char* alpha_to,
+                         const unsigned char* index_of,
+                         int nn,
+                         int fcr,
+                         int prim,
+                         int nroots)
+{
+    int i;
+
+    for (i = 0; i < nroots; i++) {
+        rs_simd_mul_table(&syndrome_tab[32 * i],
+                          (LANES * ((fcr + i) * prim % nn)) % nn,
+                          alpha_to,
+                          index_of,
+                          nn);
+        rs_simd_mul_table(
+            &chien_tab[32 * i], (LANES * (i + 1)) % nn, alpha_to, index_of, nn);
+    }
+}
+
+void rs_simd_interleaved_tables(const struct rs_simd* rs,
+                                int interleave,
+                                const unsigned char* basis,
+                                const unsigned char* basis_inv,
+                                unsigned char* tab)
+{
+    const int step = chunk_size(interleave) / interleave;
+    unsigned char mul[32];
+    int i, x, y;
+
+    for (i = 0; i < rs->nroots; i++) {
+        rs_simd_mul_table(&tab[32 * i],
+                          (step * syndrome_log(rs, i)) % rs->nn,
+                          rs->alpha_to,
+                          rs->index_of,
+                          rs->nn);
+        if (basis == NULL) {
+            continue;
+        }
+        /* The accumulators are kept in the basis of the data, so that the
+         * data does not need to be converted. The multiplication in this
+         * basis, basis_inv(c * basis(x)), is also linear over GF(2).
+         */
+        memcpy(mul, &tab[32 * i], sizeof(mul));
+        for (x = 0; x < 16; x++) {
+            y = basis[x];
+            tab[32 * i + x] = basis_inv[mul[y & 15] ^ mul[16 + (y >> 4)]];
+            y = basis[x << 4];
+            tab[32 * i + 16 + x] = basis_inv[mul[y & 15] ^ mul[16 + (y >> 4)]];
+        }
+    }
+}
+
+void rs_simd_encode_table(unsigned char* tab,
+                          const unsigned char* genpoly,
+                          const unsigned char* alpha_to,
+                          const unsigned char* index_of,
+                          int nn,
+                          int nroots)
+{
+    const int stride = RS_SIMD_ENCODE_STRIDE(nroots);
+    unsigned char mul[32];
+    int t, x;
+
+    memset(tab, 0, 32 * stride);
+    /* Parity symbol t is updated with the coefficient of x^(nroots - 1 - t) */
+    for (t = 0; t < nroots; t++) {
+        const int log_g = genpoly[nroots - 1 - t];
+        if (log_g == nn) {
+            continue;
+        }
+        rs_simd_mul_table(mul, log_g, alpha_to, index_of, nn);
+        for (x = 0; x < 32; x++) {
+            tab[x * stride + t] = mul[x];
+        }
+    }
+}
+
+/* Portable C version of the encoder, which is also used for codes with more
+ * than MAX_ENCODE_ROOTS parity symbols
+ */
+static void encode_port(const struct rs_simd* rs,
+                        const unsigned char* data,
+                        int k,
+                        int interleave,
+                        unsigned char* parity)
+{
+    const int stride = RS_SIMD_ENCODE_STRIDE(rs->nroots);
+    /* The register alternates between two buffers, so that the shift can
+     * be vectorized by the compiler. The symbol after the register is
+     * always zero.
+     */
+    unsigned char buf[2][RS_SIMD_ENCODE_STRIDE(255) + 1];
+    unsigned char *reg, *next, *tmp;
+    int j, m, t;
+
+    for (j = 0; j < interleave; j++) {
+        reg = buf[0];
+        next = buf[1];
+        memset(buf, 0, sizeof(buf));
+        for (m = 0; m < k; m++) {
+            const unsigned f = data[j + m * interleave] ^ reg[0];
+            const unsigned char* lo = &rs->encode_tab[stride * (f & 15)];
+            const unsigned char* hi = &rs->encode_tab[stride * (16 + (f >> 4))];
+            for (t = 0; t < rs->nroots; t++) {
+                next[t] = reg[t + 1] ^ lo[t] ^ hi[t];
+            }
+            tmp = reg;
+            reg = next;
+            next = tmp;
+        }
+        for (t = 0; t < rs->nroots; t++) {
+            parity[j + t * interleave] = reg[t];
+        }
+    }
+}
+
+#if defined(RS_SIMD_X86) || defined(RS_SIMD_NEON)
+/* Writes the parity symbols in reg to the interleaved parity of codeword j */
+static void store_parity(const struct rs_simd* rs,
+                         const unsigned char* reg,
+                         int j,
+                         int interleave,
+                         unsigned char* parity)
+{
+    int t;
+
+    for (t = 0; t < rs->nroots; t++) {
+        parity[j + t * interleave] = reg[t];
+    }
+}
+
+/* Combines the accumulators of the lanes of the last chunk that hold
+ * codeword j into its syndrome, whose root has index form log_beta. The
+ * accumulators are converted to the conventional basis with the basis
+ * table if it is not NULL.
+ */
+static unsigned char combine_lanes(const struct rs_simd* rs,
+                                   const unsigned char* basis,
+                                   const unsigned char* acc,
+                                   int chunk,
+                                   int interleave,
+                                   int j,
+                                   int log_beta)
+{
+    unsigned char s = 0;
+    int t;
+
+    for (t = j; t < chunk; t += interleave) {
+        if (s != 0) {
+            s = rs->alpha_to[add_mod(rs->index_of[s], log_beta, rs->nn)];
+        }
+        s ^= basis ? basis[acc[t]] : acc[t];
+    }
+    return s;
+}
+
+/* Copies the first chunk of the codewords to first, preceded by zeros so
+ * that the total length is a multiple of the chunk size. Returns the
+ * number of chunks.
+ */
+static int first_chunk(const unsigned char** data,
+                       int n,
+                       int interleave,
+                       unsigned char* first)
+{
+    const int chunk = chunk_size(interleave);
+    const int len = n * interleave;
+    const int nchunks = (len + chunk - 1) / chunk;
+    const int lead = chunk * nchunks - len;
+
+    memset(first, 0, lead);
+    memcpy(first + lead, *data, chunk - lead);
+    *data += chunk - lead;
+    return nchunks;
+}
+
+/* Writes alpha^(lambda_j + j * i) for the LANES points i = 1, 2, ..., i.e.,
+ * the initial values of term j in the Chien search
+ */
+static void
+chien_term(const struct rs_simd* rs, int lambda_j, int j, unsigned char* term)
+{
+    int a = add_mod(lambda_j, j % rs->nn, rs->nn);
+    int k;
+
+    for (k = 0; k < LANES; k++) {
+        term[k] = rs->alpha_to[a];
+        a = add_mod(a, j % rs->nn, rs->nn);
+    }
+}
+
+/* Mask of the lanes of the block starting at point i0 that correspond to
+ * valid points (i <= nn)
+ */
+static inline unsigned valid_lanes(const struct rs_simd* rs, int i0)
+{
+    const int n = rs->nn - i0 + 1;
+    return n >= LANES ? (1U << LANES) - 1 : (1U << n) - 1;
+}
+
+#endif
+
+#ifndef RS_SIMD_NEON
+/* Portable C versions */
+static void syndromes_port(const struct rs_simd* rs,
+                           const unsigned char* tab,
+                           const unsigned char* basis,
+                           const unsigned char* data,
+                           int n,
+                           int interleave,
+                           unsigned char* s)
+{
+    int i, j, k;
+
+    (void)tab;
+    for (j = 0; j < interleave; j++) {
+        for (i = 0; i < rs->nroots; i++) {
+            const int log_beta = syndrome_log(rs, i);
+            unsigned char si = basis ? basis[data[j]] : data[j];
+            for (k = 1; k < n; k++) {
+                unsigned char x = data[j + k * interleave];
+                if (basis) {
+                    x = basis[x];
+                }
+                if (si == 0) {
+                    si = x;
+                } else {
+                    si = x ^ rs->alpha_to[add_mod(rs->index_of[si], log_beta, rs->nn)];
+                }
+            }
+            s[j * rs->nroots + i] = si;
+        }
+    }
+}
+
+static int chien_port(const struct rs_simd* rs,
+                      const unsigned char* lambda,
+                      int deg_lambda,
+                      unsigned char* root)
+{
+    const int A0 = rs->nn;
+    int reg[MAX_TERMS + 1];
+    int i, j, count = 0;
+    unsigned char q;
+
+    for (j = 1; j <= deg_lambda; j++) {
+        reg[j] = lambda[j];
+    }
+    for (i = 1; i <= rs->nn; i++) {
+        q = 1; /* lambda[0] is always 0 */
+        for (j = deg_lambda; j > 0; j--) {
+            if (reg[j] != A0) {
+                reg[j] = add_mod(reg[j], j % rs->nn, rs->nn);
+                q ^= rs->alpha_to[reg[j]];
+            }
+        }
+        if (q != 0) {
+            continue;
+        }
+        root[count] = i;
+        if (++count == deg_lambda) {
+            break;
+        }
+    }
+    return count;
+}
+#endif
+
+#ifdef RS_SIMD_X86
+__attribute__((target("ssse3"))) static inline __m128i
+mul_ssse3(__m128i x, __m128i lo, __m128i hi)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    return _mm_xor_si128(
+        _mm_shuffle_epi8(lo, _mm_and_si128(x, nibble)),
+        _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(x, 4), nibble)));
+}
+
+/* The parity register is held in two vectors. Only codes with up to
+ * MAX_ENCODE_ROOTS parity symbols are supported.
+ */
+__attribute__((target("ssse3"))) static void encode_ssse3(const struct rs_simd* rs,
+                                                          const unsigned char* data,
+                                                          int k,
+                                                          int interleave,
+                                                          unsigned char* parity)
+{
+    const unsigned char* tab = rs->encode_tab;
+    unsigned char reg[MAX_ENCODE_ROOTS];
+    int j, m;
+
+    for (j = 0; j < interleave; j++) {
+        __m128i p0 = _mm_setzero_si128();
+        __m128i p1 = _mm_setzero_si128();
+        for (m = 0; m < k; m++) {
+            const unsigned f =
+                data[j + m * interleave] ^ (unsigned char)_mm_cvtsi128_si32(p0);
+            const unsigned char* lo = &tab[MAX_ENCODE_ROOTS * (f & 15)];
+            const unsigned char* hi = &tab[MAX_ENCODE_ROOTS * (16 + (f >> 4))];
+            p0 = _mm_xor_si128(
+                _mm_alignr_epi8(p1, p0, 1),
+                _mm_xor_si128(_mm_loadu_si128((const __m128i*)lo),
+                              _mm_loadu_si128((const __m128i*)hi)));
+            p1 = _mm_xor_si128(
+                _mm_srli_si128(p1, 1),
+                _mm_xor_si128(_mm_loadu_si128((const __m128i*)(lo + 16)),
+                              _mm_loadu_si128((const __m128i*)(hi + 16))));
+        }
+        _mm_storeu_si128((__m128i*)reg, p0);
+        _mm_storeu_si128((__m128i*)(reg + 16), p1);
+        store_parity(rs, reg, j, interleave, parity);
+    }
+}
+
+__attribute__((target("ssse3"))) static void syndromes_ssse3(const struct rs_simd* rs,
+                                                             const unsigned char* tab,
+                                                             const unsigned char* basis,
+                                                             const unsigned char* data,
+                                                             int n,
+                                                             int interleave,
+                                                             unsigned char* s)
+{
+    const int chunk = chunk_size(interleave);
+    const int nvec = chunk / LANES;
+    unsigned char first[MAX_CHUNK];
+    unsigned char acc[MAX_CHUNK];
+    __m128i x[MAX_CHUNK / LANES];
+    int i, j, m, v, nchunks;
+
+    nchunks = first_chunk(&data, n, interleave, first);
+    for (i = 0; i < rs->nroots; i++) {
+        const __m128i lo = _mm_loadu_si128((const __m128i*)&tab[32 * i]);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)&tab[32 * i + 16]);
+        const int log_beta = syndrome_log(rs, i);
+        for (v = 0; v < nvec; v++) {
+            x[v] = _mm_loadu_si128((const __m128i*)&first[LANES * v]);
+        }
+        for (m = 0; m < nchunks - 1; m++) {
+            for (v = 0; v < nvec; v++) {
+                x[v] = _mm_xor_si128(
+                    mul_ssse3(x[v], lo, hi),
+                    _mm_loadu_si128((const __m128i*)&data[chunk * m + LANES * v]));
+            }
+        }
+        for (v = 0; v < nvec; v++) {
+            _mm_storeu_si128((__m128i*)&acc[LANES * v], x[v]);
+        }
+        for (j = 0; j < interleave; j++) {
+            s[j * rs->nroots + i] =
+                combine_lanes(rs, basis, acc, chunk, interleave, j, log_beta);
+        }
+    }
+}
+
+__attribute__((target("ssse3"))) static int chien_ssse3(const struct rs_simd* rs,
+                                                        const unsigned char* lambda,
+                                                        int deg_lambda,
+                                                        unsigned char* root)
+{
+    __m128i terms[MAX_TERMS];
+    int powers[MAX_TERMS];
+    unsigned char init[LANES];
+    unsigned mask;
+    int i0, j, n, nterms = 0, count = 0;
+
+    if (deg_lambda == 0) {
+        return 0;
+    }
+
+    for (j = 1; j <= deg_lambda; j++) {
+        if (lambda[j] != rs->nn) {
+            chien_term(rs, lambda[j], j, init);
+            terms[nterms] = _mm_loadu_si128((const __m128i*)init);
+            powers[nterms++] = j;
+        }
+    }
+
+    for (i0 = 1; i0 <= rs->nn; i0 += LANES) {
+        __m128i q = _mm_set1_epi8(1); /* lambda[0] is always 0 */
+        for (n = 0; n < nterms; n++) {
+            q = _mm_xor_si128(q, terms[n]);
+        }
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(q, _mm_setzero_si128()));
+        mask &= valid_lanes(rs, i0);
+        while (mask) {
+            root[count] = i0 + __builtin_ctz(mask);
+            if (++count == deg_lambda) {
+                return count;
+            }
+            mask &= mask - 1;
+        }
+        for (n = 0; n < nterms; n++) {
+            const unsigned char* tab = &rs->chien_tab[32 * (powers[n] - 1)];
+            terms[n] = mul_ssse3(terms[n],
+                                 _mm_loadu_si128((const __m128i*)tab),
+                                 _mm_loadu_si128((const __m128i*)(tab + 16)));
+        }
+    }
+    return count;
+}
+
+/* Loads the first (second) half of the tables of a and b into the low and
+ * high halves of a 256-bit register
+ */
+__attribute__((target("avx2"))) static inline __m256i load_pair(const unsigned char* a,
+                                                                const unsigned char* b)
+{
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)a)),
+        _mm_loadu_si128((const __m128i*)b),
+        1);
+}
+
+__attribute__((target("avx2"))) static inline __m256i
+mul_avx2(__m256i x, __m256i lo, __m256i hi)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    return _mm256_xor_si256(
+        _mm256_shuffle_epi8(lo, _mm256_and_si256(x, nibble)),
+        _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble)));
+}
+
+/* Same as syndromes_ssse3, but with two syndromes in each register */
+__attribute__((target("avx2"))) static void syndromes_avx2(const struct rs_simd* rs,
+                                                           const unsigned char* tab,
+                                                           const unsigned char* basis,
+                                                           const unsigned char* data,
+                                                           int n,
+                                                           int interleave,
+                                                           unsigned char* s)
+{
+    const int chunk = chunk_size(interleave);
+    const int nvec = chunk / LANES;
+    unsigned char first[MAX_CHUNK];
+    unsigned char acc[2 * MAX_CHUNK];
+    __m256i x[MAX_CHUNK / LANES];
+    int i, j, m, v, nchunks;
+
+    nchunks = first_chunk(&data, n, interleave, first);
+    for (i = 0; i < rs->nroots; i += 2) {
+        /* For an odd number of roots the last syndrome is computed twice */
+        const int i1 = i + 1 < rs->nroots ? i + 1 : i;
+        const __m256i lo = load_pair(&tab[32 * i], &tab[32 * i1]);
+        const __m256i hi = load_pair(&tab[32 * i + 16], &tab[32 * i1 + 16]);
+        const int log_beta0 = syndrome_log(rs, i);
+        const int log_beta1 = syndrome_log(rs, i1);
+        for (v = 0; v < nvec; v++) {
+            x[v] = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128((const __m128i*)&first[LANES * v]));
+        }
+        for (m = 0; m < nchunks - 1; m++) {
+            for (v = 0; v < nvec; v++) {
+                x[v] = _mm256_xor_si256(
+                    mul_avx2(x[v], lo, hi),
+                    _mm256_broadcastsi128_si256(_mm_loadu_si128(
+                        (const __m128i*)&data[chunk * m + LANES * v])));
+            }
+        }
+        /* Syndrome i goes to acc[0, chunk) and syndrome i1 to
+         * acc[MAX_CHUNK, MAX_CHUNK + chunk)
+         */
+        for (v = 0; v < nvec; v++) {
+            _mm_storeu_si128((__m128i*)&acc[LANES * v], _mm256_castsi256_si128(x[v]));
+            _mm_storeu_si128((__m128i*)&acc[MAX_CHUNK + LANES * v],
+                             _mm256_extracti128_si256(x[v], 1));
+        }
+        for (j = 0; j < interleave; j++) {
+            s[j * rs->nroots + i] =
+                combine_lanes(rs, basis, acc, chunk, interleave, j, log_beta0);
+            s[j * rs->nroots + i1] = combine_lanes(
+                rs, basis, &acc[MAX_CHUNK], chunk, interleave, j, log_beta1);
+        }
+    }
+}
+
+/* Same as chien_ssse3, but with two terms in each register */
+__attribute__((target("avx2"))) static int chien_avx2(const struct rs_simd* rs,
+                                                      const unsigned char* lambda,
+                                                      int deg_lambda,
+                                                      unsigned char* root)
+{
+    __m256i terms[(MAX_TERMS + 1) / 2];
+    __m256i lo[(MAX_TERMS + 1) / 2];
+    __m256i hi[(MAX_TERMS + 1) / 2];
+    unsigned char init[2 * LANES];
+    const unsigned char* tab[2];
+    unsigned mask;
+    int i0, j, n, h, npairs = 0, count = 0;
+
+    if (deg_lambda == 0) {
+        return 0;
+    }
+
+    /* The unused half of the last pair is zero, and it stays zero */
+    memset(init, 0, sizeof(init));
+    h = 0;
+    for (j = 1; j <= deg_lambda; j++) {
+        if (lambda[j] != rs->nn) {
+            chien_term(rs, lambda[j], j, &init[LANES * h]);
+            tab[h] = &rs->chien_tab[32 * (j - 1)];
+            if (++h == 2) {
+                terms[npairs] = _mm256_loadu_si256((const __m256i*)init);
+                lo[npairs] = load_pair(tab[0], tab[1]);
+                hi[npairs++] = load_pair(tab[0] + 16, tab[1] + 16);
+                h = 0;
+            }
+        }
+    }
+    if (h == 1) {
+        memset(&init[LANES], 0, LANES);
+        terms[npairs] = _mm256_loadu_si256((const __m256i*)init);
+        lo[npairs] = load_pair(tab[0], tab[0]);
+        hi[npairs++] = load_pair(tab[0] + 16, tab[0] + 16);
+    }
+
+    for (i0 = 1; i0 <= rs->nn; i0 += LANES) {
+        __m256i q2 = _mm256_setzero_si256();
+        __m128i q;
+        for (n = 0; n < npairs; n++) {
+            q2 = _mm256_xor_si256(q2, terms[n]);
+        }
+        q = _mm_xor_si128(_mm256_castsi256_si128(q2), _mm256_extracti128_si256(q2, 1));
+        q = _mm_xor_si128(q, _mm_set1_epi8(1)); /* lambda[0] is always 0 */
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(q, _mm_setzero_si128()));
+        mask &= valid_lanes(rs, i0);
+        while (mask) {
+            root[count] = i0 + __builtin_ctz(mask);
+            if (++count == deg_lambda) {
+                return count;
+            }
+            mask &= mask - 1;
+        }
+        for (n = 0; n < npairs; n++) {
+            terms[n] = mul_avx2(terms[n], lo[n], hi[n]);
+        }
+    }
+    return count;
+}
+#endif
+
+#ifdef RS_SIMD_NEON
+static inline uint8x16_t mul_neon(uint8x16_t x, uint8x16_t lo, uint8x16_t hi)
+{
+    return veorq_u8(vqtbl1q_u8(lo, vandq_u8(x, vdupq_n_u8(0x0f))),
+                    vqtbl1q_u8(hi, vshrq_n_u8(x, 4)));
+}
+
+/* Same as encode_ssse3 */
+static void encode_neon(const struct rs_simd* rs,
+                        const unsigned char* data,
+                        int k,
+                        int interleave,
+                        unsigned char* parity)
+{
+    const unsigned char* tab = rs->encode_tab;
+    const uint8x16_t zero = vdupq_n_u8(0);
+    unsigned char reg[MAX_ENCODE_ROOTS];
+    int j, m;
+
+    for (j = 0; j < interleave; j++) {
+        uint8x16_t p0 = zero;
+        uint8x16_t p1 = zero;
+        for (m = 0; m < k; m++) {
+            const unsigned f = data[j + m * interleave] ^ vgetq_lane_u8(p0, 0);
+            const unsigned char* lo = &tab[MAX_ENCODE_ROOTS * (f & 15)];
+            const unsigned char* hi = &tab[MAX_ENCODE_ROOTS * (16 + (f >> 4))];
+            p0 = veorq_u8(vextq_u8(p0, p1, 1), veorq_u8(vld1q_u8(lo), vld1q_u8(hi)));
+            p1 = veorq_u8(vextq_u8(p1, zero, 1),
+                          veorq_u8(vld1q_u8(lo + 16), vld1q_u8(hi + 16)));
+        }
+        vst1q_u8(reg, p0);
+        vst1q_u8(reg + 16, p1);
+        store_parity(rs, reg, j, interleave, parity);
+    }
+}
+
+static void syndromes_neon(const struct rs_simd* rs,
+                           const unsigned char* tab,
+                           const unsigned char* basis,
+                           const unsigned char* data,
+                           int n,
+                           int interleave,
+                           unsigned char* s)
+{
+    const int chunk = chunk_size(interleave);
+    const int nvec = chunk / LANES;
+    unsigned char first[MAX_CHUNK];
+    unsigned char acc[MAX_CHUNK];
+    uint8x16_t x[MAX_CHUNK / LANES];
+    int i, j, m, v, nchunks;
+
+    nchunks = first_chunk(&data, n, interleave, first);
+    for (i = 0; i < rs->nroots; i++) {
+        const uint8x16_t lo = vld1q_u8(&tab[32 * i]);
+        const uint8x16_t hi = vld1q_u8(&tab[32 * i + 16]);
+        const int log_beta = syndrome_log(rs, i);
+        for (v = 0; v < nvec; v++) {
+            x[v] = vld1q_u8(&first[LANES * v]);
+        }
+        for (m = 0; m < nchunks - 1; m++) {
+            for (v = 0; v < nvec; v++) {
+                x[v] = veorq_u8(mul_neon(x[v], lo, hi),
+                                vld1q_u8(&data[chunk * m + LANES * v]));
+            }
+        }
+        for (v = 0; v < nvec; v++) {
+            vst1q_u8(&acc[LANES * v], x[v]);
+        }
+        for (j = 0; j < interleave; j++) {
+            s[j * rs->nroots + i] =
+                combine_lanes(rs, basis, acc, chunk, interleave, j, log_beta);
+        }
+    }
+}
+
+static int chien_neon(const struct rs_simd* rs,
+                      const unsigned char* lambda,
+                      int deg_lambda,
+                      unsigned char* root)
+{
+    uint8x16_t terms[MAX_TERMS];
+    int powers[MAX_TERMS];
+    unsigned char init[LANES];
+    unsigned char zero[LANES];
+    unsigned mask;
+    int i0, j, k, n, nterms = 0, count = 0;
+
+    if (deg_lambda == 0) {
+        return 0;
+    }
+
+    for (j = 1; j <= deg_lambda; j++) {
+        if (lambda[j] != rs->nn) {
+            chien_term(rs, lambda[j], j, init);
+            terms[nterms] = vld1q_u8(init);
+            powers[nterms++] = j;
+        }
+    }
+
+    for (i0 = 1; i0 <= rs->nn; i0 += LANES) {
+        uint8x16_t q = vdupq_n_u8(1); /* lambda[0] is always 0 */
+        uint8x16_t is_zero;
+        for (n = 0; n < nterms; n++) {
+            q = veorq_u8(q, terms[n]);
+        }
+        is_zero = vceqzq_u8(q);
+        if (vmaxvq_u8(is_zero)) {
+            vst1q_u8(zero, is_zero);
+            mask = valid_lanes(rs, i0);
+            for (k = 0; k < LANES; k++) {
+                if (zero[k] && (mask & (1U << k))) {
+                    root[count] = i0 + k;
+                    if (++count == deg_lambda) {
+                        return count;
+                    }
+                }
+            }
+        }
+        for (n = 0; n < nterms; n++) {
+            const unsigned char* tab = &rs->chien_tab[32 * (powers[n] - 1)];
+            terms[n] = mul_neon(terms[n], vld1q_u8(tab), vld1q_u8(tab + 16));
+        }
+    }
+    return count;
+}
+#endif
+
+void rs_simd_select_kernels(struct rs_simd* rs)
+{
+#ifdef RS_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        rs->syndromes = syndromes_avx2;
+        rs->chien = chien_avx2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        rs->syndromes = syndromes_ssse3;
+        rs->chien = chien_ssse3;
+    } else {
+        rs->syndromes = syndromes_port;
+        rs->chien = chien_port;
+    }
+    rs->encode = __builtin_cpu_supports("ssse3") ? encode_ssse3 : encode_port;
+#elif defined(RS_SIMD_NEON)
+    rs->syndromes = syndromes_neon;
+    rs->chien = chien_neon;
+    rs->encode = encode_neon;
+#else
+    rs->syndromes = syndromes_port;
+    rs->chien = chien_port;
+    rs->encode = encode_port;
+#endif
+    if (rs->nroots > MAX_ENCODE_ROOTS) {
+        rs->encode = encode_port;
+    }
+}
+
+void rs_simd_encode(const struct rs_simd* rs,
+                    const unsigned char* data,
+                    int k,
+                    int interleave,
+                    unsigned char* parity)
+{
+    rs->encode(rs, data, k, interleave, parity);
+}
+
+int rs_simd_syndromes(const struct rs_simd* rs,
+                      const unsigned char* data,
+                      int len,
+                      unsigned char* s)
+{
+    int i, syn_error = 0;
+
+    rs->syndromes(rs, rs->syndrome_tab, NULL, data, len, 1, s);
+    for (i = 0; i < rs->nroots; i++) {
+        syn_error |= s[i];
+    }
+    return syn_error;
+}
+
+unsigned rs_simd_syndromes_interleaved(const struct rs_simd* rs,
+                                       const unsigned char* tab,
+                                       const unsigned char* basis,
+                                       const unsigned char* data,
+                                       int n,
+                                       int interleave,
+                                       unsigned char* s)
+{
+    unsigned mask = 0;
+    int i, j;
+
+    rs->syndromes(rs, tab, basis, data, n, interleave, s);
+    for (j = 0; j < interleave; j++) {
+        for (i = 0; i < rs->nroots; i++) {
+            if (s[j * rs->nroots + i]) {
+                mask |= 1U << j;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+int rs_simd_chien(const struct rs_simd* rs,
+                  const unsigned char* lambda,
+                  int deg_lambda,
+                  unsigned char* root)
+{
+    return rs->chien(rs, lambda, deg_lambda, root);
+}
@@ -0,0 +1,171 @@
+/* SIMD encoding, syndrome computation and Chien search for Reed-Solomon
+ * codes with symbols of up to 8 bits
+ *
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ * May be used under the terms of the GNU Lesser General Public License (LGPL)
+ */
+#ifndef _RS_SIMD_H_
+#define _RS_SIMD_H_
+
+/* Galois field multiplication by a constant c uses split-nibble tables,
+ * which hold c * x for x = 0, ..., 15 in the first 16 bytes and c * (x << 4)
+ * for x = 0, ..., 15 in the last 16 bytes, so that c * x is
+ * tab[x & 15] ^ tab[16 + (x >> 4)]. This can be computed for 16 or 32
+ * symbols at once with byte shuffle instructions (pshufb or tbl).
+ *
+ * The syndromes are computed with 16 interleaved Horner recurrences, each
+ * of them handling one in 16 symbols, so that all the lanes are multiplied
+ * by the same constant (alpha^(16 * (fcr + i) * prim)). The Chien search
+ * evaluates the error locator polynomial at 16 consecutive points at once,
+ * multiplying term j by alpha^(16 * j) in each step.
+ *
+ * The syndromes of several interleaved codewords can be computed directly
+ * from the interleaved data by processing chunks of lcm(16, interleave)
+ * symbols, so that each lane always holds symbols of the same codeword.
+ *
+ * The encoder keeps the whole parity register in vector registers. For each
+ * input symbol, the feedback symbol f is multiplied by all the generator
+ * polynomial coefficients at once by looking up the rows for the two
+ * nibbles of f in a table that holds x * g and (x << 4) * g, x = 0, ..., 15,
+ * and the result is added to the register shifted by one symbol.
+ */
+
+/* Maximum interleave depth supported by rs_simd_syndromes_interleaved() */
+#define RS_SIMD_MAX_INTERLEAVE 16
+
+/* Length of the rows of the encoder table */
+#define RS_SIMD_ENCODE_STRIDE(nroots) (((nroots) + 31) & ~31)
+
+struct rs_simd;
+
+/* Kernels, selected by rs_simd_select_kernels() according to the CPU */
+typedef void (*rs_simd_encode_kernel)(const struct rs_simd* rs,
+                                      const unsigned char* data,
+                                      int k,
+                                      int interleave,
+                                      unsigned char* parity);
+typedef void (*rs_simd_syndromes_kernel)(const struct rs_simd* rs,
+                                         const unsigned char* tab,
+                                         const unsigned char* basis,
+                                         const unsigned char* data,
+                                         int n,
+                                         int interleave,
+                                         unsigned char* s);
+typedef int (*rs_simd_chien_kernel)(const struct rs_simd* rs,
+                                    const unsigned char* lambda,
+                                    int deg_lambda,
+                                    unsigned char* root);
+
+struct rs_simd {
+    int nn;     /* Symbols per block (= (1<<mm)-1) */
+    int nroots; /* Number of generator roots */
+    int fcr;    /* First consecutive root, index form */
+    int prim;   /* Primitive element, index form */
+    const unsigned char* alpha_to;
+    const unsigned char* index_of;
+    /* Tables for alpha^(16 * (fcr + i) * prim), i = 0, ..., nroots - 1 */
+    const unsigned char* syndrome_tab;
+    /* Tables for alpha^(16 * j), j = 1, ..., nroots */
+    const unsigned char* chien_tab;
+    /* Encoder table, with 32 rows of RS_SIMD_ENCODE_STRIDE(nroots) bytes */
+    const unsigned char* encode_tab;
+    rs_simd_encode_kernel encode;
+    rs_simd_syndromes_kernel syndromes;
+    rs_simd_chien_kernel chien;
+};
+
+/* Selects the kernels used by rs according to the CPU features and the
+ * number of roots. This must be called once after the other fields of rs
+ * are filled and before rs is used.
+ */
+void rs_simd_select_kernels(struct rs_simd* rs);
+
+/* Fills the split-nibble table for the multiplication by the constant whose
+ * index form is log_c
+ */
+void rs_simd_mul_table(unsigned char* tab,
+                       int log_c,
+                       const unsigned char* alpha_to,
+                       const unsigned char* index_of,
+                       int nn);
+
+/* Fills the syndrome and Chien search tables, which have nroots * 32 bytes
+ * each
+ */
+void rs_simd_init_tables(unsigned char* syndrome_tab,
+                         unsigned char* chien_tab,
+                         const unsigned char* alpha_to,
+                         const unsigned char* index_of,
+                         int nn,
+                         int fcr,
+                         int prim,
+                         int nroots);
+
+/* Fills the encoder table from the generator polynomial genpoly, given in
+ * index form
+ */
+void rs_simd_encode_table(unsigned char* tab,
+                          const unsigned char* genpoly,
+                          const unsigned char* alpha_to,
+                          const unsigned char* index_of,
+                          int nn,
+                          int nroots);
+
+/* Computes the parity symbols of interleave codewords with k data symbols,
+ * where data symbol m of codeword j is data[j + m * interleave]. Parity
+ * symbol m of codeword j is written to parity[j + m * interleave], so that
+ * the parity follows the data as in an interleaved codeword.
+ */
+void rs_simd_encode(const struct rs_simd* rs,
+                    const unsigned char* data,
+                    int k,
+                    int interleave,
+                    unsigned char* parity);
+
+/* Computes the syndromes of the len symbols in data, in polynomial form.
+ * Returns nonzero if any syndrome is nonzero.
+ */
+int rs_simd_syndromes(const struct rs_simd* rs,
+                      const unsigned char* data,
+                      int len,
+                      unsigned char* s);
+
+/* Fills the tables used by rs_simd_syndromes_interleaved() for an
+ * interleave depth, which have nroots * 32 bytes. If basis is not NULL,
+ * the data is given in another basis of GF(2^8) (such as the CCSDS dual
+ * basis), and basis and basis_inv map symbols from that basis to the
+ * conventional one and back.
+ */
+void rs_simd_interleaved_tables(const struct rs_simd* rs,
+                                int interleave,
+                                const unsigned char* basis,
+                                const unsigned char* basis_inv,
+                                unsigned char* tab);
+
+/* Computes the syndromes of interleave codewords of n symbols, where symbol
+ * k of codeword j is data[j + k * interleave], using the tables filled by
+ * rs_simd_interleaved_tables(), and the same basis table, which converts the
+ * data to the conventional basis without copying it. The syndromes of
+ * codeword j are written in polynomial form (in the conventional basis) to
+ * s[j * nroots], ..., s[j * nroots + nroots - 1].
+ * Returns a mask with bit j set if codeword j has a nonzero syndrome.
+ */
+unsigned rs_simd_syndromes_interleaved(const struct rs_simd* rs,
+                                       const unsigned char* tab,
+                                       const unsigned char* basis,
+                                       const unsigned char* data,
+                                       int n,
+                                       int interleave,
+                                       unsigned char* s);
+
+/* Finds the roots alpha^i, i = 1, ..., nn, of the error locator polynomial
+ * lambda, given in index form, and writes the values of i in increasing
+ * order to root. The search stops after deg_lambda roots are found.
+ * Returns the number of roots found.
+ */
+int rs_simd_chien(const struct rs_simd* rs,
+                  const unsigned char* lambda,
+                  int deg_lambda,
+                  unsigned char* root);
+
+#endif /* _RS_SIMD_H_ */
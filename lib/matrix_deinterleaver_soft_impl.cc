@@ -74,16 +74,29 @@ int matrix_deinterleaver_soft_impl::general_work(int noutput_items,
 
 void matrix_deinterleaver_soft_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
+    const auto msg = pmt::cdr(pmt_msg);
     size_t length(0);
-    auto data = pmt::f32vector_elements(pmt::cdr(pmt_msg), length);
+
+    if (pmt::is_s8vector(msg)) {
+        // Soft symbols quantized to int8
+        auto data = pmt::s8vector_elements(msg, length);
+        if (length != d_rows * d_cols)
+            return;
+        d_out_s8.resize(length);
+        deinterleave(data, d_out_s8.data());
+        message_port_pub(
+            pmt::mp("out"),
+            pmt::cons(pmt::PMT_NIL,
+                      pmt::init_s8vector(d_output_size, &d_out_s8[d_output_skip])));
+        return;
+    }
+
+    auto data = pmt::f32vector_elements(msg, length);
 
     if (length != d_rows * d_cols)
         return;
 
-    // Full matrix deinterleave, ignoring output cropping
-    for (size_t i = 0; i < length; ++i) {
-        d_out[i] = data[d_rows * (i % d_cols) + i / d_cols];
-    }
+    deinterleave(data, d_out.data());
 
     // Output cropping
     message_port_pub(
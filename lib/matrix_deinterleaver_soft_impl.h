@@ -26,6 +26,16 @@ private:
     const size_t d_output_size;
     const size_t d_output_skip;
     std::vector<float> d_out;
+    std::vector<int8_t> d_out_s8;
+
+    template <typename T>
+    void deinterleave(const T* in, T* out) const
+    {
+        // Full matrix deinterleave, ignoring output cropping
+        for (size_t i = 0; i < d_rows * d_cols; ++i) {
+            out[i] = in[d_rows * (i % d_cols) + i / d_cols];
+        }
+    }
 
 public:
     matrix_deinterleaver_soft_impl(int rows, int cols, int output_size, int output_skip);
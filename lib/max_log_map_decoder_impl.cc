@@ -0,0 +1,246 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "max_log_map_decoder_impl.h"
+#include "viterbi/viterbi.h"
+#include <gnuradio/io_signature.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+namespace satellites {
+
+namespace {
+// Metric used for the unreachable states. It is small enough to lose
+// against any reachable path, but adding branch metrics to it does not
+// overflow.
+constexpr float kUnreachable = -1e30f;
+
+int parity(int x)
+{
+    int p = 0;
+    for (; x; x >>= 1) {
+        p ^= x & 1;
+    }
+    return p;
+}
+} // namespace
+
+max_log_map_decoder::sptr max_log_map_decoder::make(int constraint,
+                                                    const std::vector<int>& polynomials,
+                                                    const std::vector<int>& puncturing)
+{
+    return gnuradio::make_block_sptr<max_log_map_decoder_impl>(
+        constraint, polynomials, puncturing);
+}
+
+/*
+ * The private constructor
+ */
+max_log_map_decoder_impl::max_log_map_decoder_impl(int constraint,
+                                                   const std::vector<int>& polynomials,
+                                                   const std::vector<int>& puncturing)
+    : gr::block("max_log_map_decoder",
+                gr::io_signature::make(0, 0, 0),
+                gr::io_signature::make(0, 0, 0)),
+      d_constraint(constraint),
+      d_num_states(1 << (constraint - 1)),
+      d_num_parity_bits(polynomials.size()),
+      d_puncturing(puncturing)
+{
+    if ((constraint < 2) || (constraint > 16)) {
+        throw std::runtime_error("constraint must be between 2 and 16");
+    }
+    if (polynomials.empty() || (polynomials.size() > 32)) {
+        throw std::runtime_error("the number of polynomials must be between 1 and 32");
+    }
+    for (auto p : polynomials) {
+        if ((p <= 0) || (p >= (1 << constraint))) {
+            throw std::runtime_error("invalid polynomial");
+        }
+    }
+    if (!ViterbiCodec::ValidPuncturing(puncturing, polynomials.size())) {
+        throw std::runtime_error("invalid puncturing pattern");
+    }
+
+    d_outputs.resize(1 << constraint);
+    for (int reg = 0; reg < (1 << constraint); ++reg) {
+        uint32_t out = 0;
+        for (int j = 0; j < d_num_parity_bits; ++j) {
+            out |= parity(reg & polynomials[j]) << j;
+        }
+        d_outputs[reg] = out;
+    }
+    d_branch.resize(1 << constraint);
+    d_beta.resize(d_num_states);
+    d_new_beta.resize(d_num_states);
+
+    message_port_register_out(pmt::mp("out"));
+    message_port_register_out(pmt::mp("llr"));
+    message_port_register_in(pmt::mp("in"));
+    set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->msg_handler(msg); });
+}
+
+/*
+ * Our virtual destructor.
+ */
+max_log_map_decoder_impl::~max_log_map_decoder_impl() {}
+
+int max_log_map_decoder_impl::general_work(int noutput_items,
+                                           gr_vector_int& ninput_items,
+                                           gr_vector_const_void_star& input_items,
+                                           gr_vector_void_star& output_items)
+{
+    return 0;
+}
+
+bool max_log_map_decoder_impl::get_symbols(pmt::pmt_t msg)
+{
+    size_t size;
+    const uint8_t* bits = nullptr;
+    const int8_t* soft8 = nullptr;
+    const float* soft = nullptr;
+
+    if (pmt::is_u8vector(msg)) {
+        bits = pmt::u8vector_elements(msg, size);
+    } else if (pmt::is_s8vector(msg)) {
+        soft8 = pmt::s8vector_elements(msg, size);
+    } else if (pmt::is_f32vector(msg)) {
+        soft = pmt::f32vector_elements(msg, size);
+    } else {
+        return false;
+    }
+
+    d_symbols.clear();
+    size_t pos = 0;
+    for (size_t j = 0; j < size; ++j) {
+        // Erasures for the punctured positions
+        if (!d_puncturing.empty()) {
+            while (!d_puncturing[pos]) {
+                d_symbols.push_back(0.0f);
+                pos = (pos + 1) % d_puncturing.size();
+            }
+            pos = (pos + 1) % d_puncturing.size();
+        }
+        if (bits) {
+            d_symbols.push_back(bits[j] ? 1.0f : -1.0f);
+        } else if (soft8) {
+            d_symbols.push_back(soft8[j]);
+        } else {
+            d_symbols.push_back(soft[j]);
+        }
+    }
+    // Erasures to complete the last trellis step
+    while (d_symbols.size() % d_num_parity_bits) {
+        d_symbols.push_back(0.0f);
+    }
+
+    return true;
+}
+
+void max_log_map_decoder_impl::branch_metrics(int t)
+{
+    // The branch metric is half the correlation between the symbols and
+    // the encoder output in +/-1 form, so that the output LLRs have the
+    // same scale as the input symbols.
+    const float* symbols = &d_symbols[t * d_num_parity_bits];
+    for (size_t reg = 0; reg < d_branch.size(); ++reg) {
+        float metric = 0.0f;
+        for (int j = 0; j < d_num_parity_bits; ++j) {
+            metric += (d_outputs[reg] >> j) & 1 ? symbols[j] : -symbols[j];
+        }
+        d_branch[reg] = 0.5f * metric;
+    }
+}
+
+void max_log_map_decoder_impl::decode()
+{
+    const int S = d_num_states;
+    const int num_steps = d_symbols.size() / d_num_parity_bits;
+    // The last constraint - 1 steps correspond to the zero flushing bits
+    const int num_bits = std::max(0, num_steps - (d_constraint - 1));
+
+    // Forward recursion. The predecessors of state s are the shift register
+    // contents s and s + S, with states (s >> 1) and (s >> 1) + S / 2.
+    d_alpha.assign((num_steps + 1) * S, kUnreachable);
+    d_alpha[0] = 0.0f;
+    for (int t = 0; t < num_steps; ++t) {
+        branch_metrics(t);
+        const float* alpha = &d_alpha[t * S];
+        float* next = &d_alpha[(t + 1) * S];
+        // Only the zero input is possible during the flushing bits
+        const int step = t < num_bits ? 1 : 2;
+        float best = kUnreachable;
+        for (int s = 0; s < S; s += step) {
+            next[s] = std::max(alpha[s >> 1] + d_branch[s],
+                               alpha[(s + S) >> 1] + d_branch[s + S]);
+            best = std::max(best, next[s]);
+        }
+        for (int s = 0; s < S; s += step) {
+            next[s] -= best;
+        }
+    }
+
+    // Backward recursion and LLR computation. The codeword ends in the zero
+    // state.
+    d_llr.resize(num_bits);
+    d_hard.resize(num_bits);
+    std::fill(d_beta.begin(), d_beta.end(), kUnreachable);
+    d_beta[0] = 0.0f;
+    for (int t = num_steps - 1; t >= 0; --t) {
+        branch_metrics(t);
+        const float* alpha = &d_alpha[t * S];
+        const int num_inputs = t < num_bits ? 2 : 1;
+        float best_input[2] = { kUnreachable, kUnreachable };
+        float best = kUnreachable;
+        for (int s = 0; s < S; ++s) {
+            float beta = kUnreachable;
+            for (int u = 0; u < num_inputs; ++u) {
+                const int reg = (s << 1) | u;
+                const float metric = d_branch[reg] + d_beta[reg & (S - 1)];
+                beta = std::max(beta, metric);
+                best_input[u] = std::max(best_input[u], alpha[s] + metric);
+            }
+            d_new_beta[s] = beta;
+            best = std::max(best, beta);
+        }
+        for (int s = 0; s < S; ++s) {
+            d_beta[s] = d_new_beta[s] - best;
+        }
+        if (t < num_bits) {
+            d_llr[t] = best_input[1] - best_input[0];
+            d_hard[t] = d_llr[t] > 0.0f;
+        }
+    }
+}
+
+void max_log_map_decoder_impl::msg_handler(pmt::pmt_t pmt_msg)
+{
+    if (!get_symbols(pmt::cdr(pmt_msg))) {
+        d_logger->error("Invalid PDU type; dropping");
+        return;
+    }
+
+    decode();
+
+    const pmt::pmt_t meta = pmt::car(pmt_msg);
+    message_port_pub(pmt::mp("out"),
+                     pmt::cons(meta, pmt::init_u8vector(d_hard.size(), d_hard)));
+    message_port_pub(pmt::mp("llr"),
+                     pmt::cons(meta, pmt::init_f32vector(d_llr.size(), d_llr)));
+}
+
+} /* namespace satellites */
+} /* namespace gr */
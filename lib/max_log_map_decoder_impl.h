@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_IMPL_H
+#define INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_IMPL_H
+
+#include <satellites/max_log_map_decoder.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace gr {
+namespace satellites {
+
+class max_log_map_decoder_impl : public max_log_map_decoder
+{
+private:
+    const int d_constraint;
+    const int d_num_states;
+    const int d_num_parity_bits;
+    const std::vector<int> d_puncturing;
+    // Parity bits for each shift register contents, with the newest input
+    // bit in the LSB. Bit j corresponds to polynomial j.
+    std::vector<uint32_t> d_outputs;
+
+    std::vector<float> d_symbols;
+    std::vector<float> d_branch;
+    // Forward metrics for each trellis step
+    std::vector<float> d_alpha;
+    std::vector<float> d_beta;
+    std::vector<float> d_new_beta;
+    std::vector<float> d_llr;
+    std::vector<uint8_t> d_hard;
+
+    // Reads the PDU contents into d_symbols, inserting erasures in the
+    // punctured positions. Returns false if the PDU type is invalid.
+    bool get_symbols(pmt::pmt_t msg);
+    // Computes the branch metrics of trellis step t for each shift register
+    // contents.
+    void branch_metrics(int t);
+    // Decodes the codeword in d_symbols, writing d_llr and d_hard.
+    void decode();
+
+public:
+    max_log_map_decoder_impl(int constraint,
+                             const std::vector<int>& polynomials,
+                             const std::vector<int>& puncturing);
+    ~max_log_map_decoder_impl();
+
+    int general_work(int noutput_items,
+                     gr_vector_int& ninput_items,
+                     gr_vector_const_void_star& input_items,
+                     gr_vector_void_star& output_items);
+
+    void msg_handler(pmt::pmt_t pmt_msg);
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_MAX_LOG_MAP_DECODER_IMPL_H */
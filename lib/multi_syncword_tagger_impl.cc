@@ -0,0 +1,187 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "multi_syncword_tagger_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/math.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MULTI_SYNCWORD_POPCNT_X86
+#endif
+
+namespace gr {
+namespace satellites {
+
+namespace {
+
+inline int popcount(uint64_t x)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    for (; x; x &= x - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Finds the windows that differ from the syncword in at most threshold of
+// the bits given by mask. Writes their indices to matches and their number
+// of bit errors to errors, and returns the number of matches.
+inline size_t find_matches(const uint64_t* windows,
+                           size_t n,
+                           uint64_t syncword,
+                           uint64_t mask,
+                           unsigned threshold,
+                           uint32_t* matches,
+                           uint8_t* errors)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const int nwrong = popcount((windows[i] ^ syncword) & mask);
+        if (static_cast<unsigned>(nwrong) <= threshold) {
+            matches[found] = i;
+            errors[found] = nwrong;
+            ++found;
+        }
+    }
+    return found;
+}
+
+#ifdef MULTI_SYNCWORD_POPCNT_X86
+// Without -mpopcnt, __builtin_popcountll() is a library call, so
+// find_matches() is also inlined into a function that can use the popcnt
+// instruction
+__attribute__((target("popcnt"))) size_t find_matches_popcnt(const uint64_t* windows,
+                                                             size_t n,
+                                                             uint64_t syncword,
+                                                             uint64_t mask,
+                                                             unsigned threshold,
+                                                             uint32_t* matches,
+                                                             uint8_t* errors)
+{
+    return find_matches(windows, n, syncword, mask, threshold, matches, errors);
+}
+
+bool have_popcnt() { return __builtin_cpu_supports("popcnt"); }
+#endif
+
+} // namespace
+
+multi_syncword_tagger::sptr
+multi_syncword_tagger::make(const std::vector<std::string>& syncwords,
+                            const std::vector<int>& thresholds,
+                            const std::vector<std::string>& tag_names)
+{
+    return gnuradio::make_block_sptr<multi_syncword_tagger_impl>(
+        syncwords, thresholds, tag_names);
+}
+
+/*
+ * The private constructor
+ */
+multi_syncword_tagger_impl::multi_syncword_tagger_impl(
+    const std::vector<std::string>& syncwords,
+    const std::vector<int>& thresholds,
+    const std::vector<std::string>& tag_names)
+    : gr::sync_block("multi_syncword_tagger",
+                     gr::io_signature::make(1, 1, sizeof(float)),
+                     gr::io_signature::make(1, 1, sizeof(float))),
+      d_data_reg(0)
+{
+    if (thresholds.size() != syncwords.size() || tag_names.size() != syncwords.size()) {
+        throw std::runtime_error(
+            "The number of syncwords, thresholds and tag names must be the same");
+    }
+
+    for (size_t k = 0; k < syncwords.size(); ++k) {
+        const auto& syncword = syncwords[k];
+        if (syncword.empty() || syncword.size() > 64) {
+            throw std::runtime_error("Syncword length must be between 1 and 64 bits");
+        }
+        if (thresholds[k] < 0) {
+            throw std::runtime_error("Syncword threshold must be non-negative");
+        }
+        // look at LSB only, as in correlate_access_code_bb_impl.cc
+        uint64_t value = 0;
+        for (auto s : syncword) {
+            value = (value << 1) | (s & 1);
+        }
+        d_syncwords.push_back(value);
+        d_masks.push_back(~uint64_t{ 0 } >> (64 - syncword.size()));
+        d_thresholds.push_back(thresholds[k]);
+        d_keys.push_back(pmt::mp(tag_names[k]));
+    }
+}
+
+/*
+ * Our virtual destructor.
+ */
+multi_syncword_tagger_impl::~multi_syncword_tagger_impl() {}
+
+int multi_syncword_tagger_impl::work(int noutput_items,
+                                     gr_vector_const_void_star& input_items,
+                                     gr_vector_void_star& output_items)
+{
+    const float* in = (const float*)input_items[0];
+    float* out = (float*)output_items[0];
+    std::copy_n(in, noutput_items, out);
+
+    // Slice the input once for all the syncwords
+    const size_t n = noutput_items;
+    if (d_windows.size() < n) {
+        d_windows.resize(n);
+        d_matches.resize(n);
+        d_errors.resize(n);
+    }
+    uint64_t reg = d_data_reg;
+    for (size_t i = 0; i < n; ++i) {
+        d_windows[i] = reg;
+        reg = (reg << 1) | (gr::branchless_binary_slicer(in[i]) & 1);
+    }
+    d_data_reg = reg;
+
+#ifdef MULTI_SYNCWORD_POPCNT_X86
+    const auto find = have_popcnt() ? find_matches_popcnt : find_matches;
+#else
+    const auto find = find_matches;
+#endif
+    const uint64_t abs_out_sample_cnt = nitems_written(0);
+    for (size_t k = 0; k < d_syncwords.size(); ++k) {
+        const size_t found = find(d_windows.data(),
+                                  n,
+                                  d_syncwords[k],
+                                  d_masks[k],
+                                  d_thresholds[k],
+                                  d_matches.data(),
+                                  d_errors.data());
+        for (size_t m = 0; m < found; ++m) {
+            add_item_tag(0,
+                         abs_out_sample_cnt + d_matches[m],
+                         d_keys[k],
+                         pmt::from_long(d_errors[m]),
+                         alias_pmt());
+        }
+    }
+
+    return noutput_items;
+}
+
+} /* namespace satellites */
+} /* namespace gr */
@@ -0,0 +1,52 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_IMPL_H
+#define INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_IMPL_H
+
+#include <satellites/multi_syncword_tagger.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace gr {
+namespace satellites {
+
+class multi_syncword_tagger_impl : public multi_syncword_tagger
+{
+private:
+    // Syncwords, right-aligned, with their masks, thresholds and tag keys
+    std::vector<uint64_t> d_syncwords;
+    std::vector<uint64_t> d_masks;
+    std::vector<unsigned> d_thresholds;
+    std::vector<pmt::pmt_t> d_keys;
+
+    // Last 64 sliced bits, with the newest in the LSB
+    uint64_t d_data_reg;
+    // d_windows[i] holds d_data_reg before shifting in input item i
+    std::vector<uint64_t> d_windows;
+    std::vector<uint32_t> d_matches;
+    std::vector<uint8_t> d_errors;
+
+public:
+    multi_syncword_tagger_impl(const std::vector<std::string>& syncwords,
+                               const std::vector<int>& thresholds,
+                               const std::vector<std::string>& tag_names);
+    ~multi_syncword_tagger_impl() override;
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items) override;
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_MULTI_SYNCWORD_TAGGER_IMPL_H */
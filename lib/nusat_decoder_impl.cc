@@ -13,6 +13,7 @@
 #endif
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <gnuradio/logger.h>
 
@@ -20,6 +21,7 @@
 #include <gnuradio/io_signature.h>
 
 #include "rs.h"
+#include "rs_cache.h"
 
 extern "C" {
 #include "libfec/fec.h"
@@ -71,7 +73,10 @@ nusat_decoder_impl::nusat_decoder_impl()
                 gr::io_signature::make(0, 0, 0),
                 gr::io_signature::make(0, 0, 0))
 {
-    d_rs = init_rs_char(8, 0x11d, 1, 1, 4, 0);
+    d_rs = get_rs_char(8, 0x11d, 1, 1, 4);
+    if (!d_rs) {
+        throw std::runtime_error("Unable to initialize Reed-Solomon definition");
+    }
 
     message_port_register_out(pmt::mp("out"));
     message_port_register_in(pmt::mp("in"));
@@ -81,7 +86,7 @@ nusat_decoder_impl::nusat_decoder_impl()
 /*
  * Our virtual destructor.
  */
-nusat_decoder_impl::~nusat_decoder_impl() { free_rs_char(d_rs); }
+nusat_decoder_impl::~nusat_decoder_impl() {}
 
 void nusat_decoder_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required)
 {
@@ -116,7 +121,7 @@ void nusat_decoder_impl::msg_handler(pmt::pmt_t pmt_msg)
     memcpy(d_data.data(), msg, msg_length);
 
     // Reed-Solomon decoding
-    auto rs_res = decode_rs_char(d_rs, d_data.data(), NULL, 0);
+    auto rs_res = decode_rs_char(d_rs.get(), d_data.data(), NULL, 0);
     if (rs_res < 0) {
         d_logger->info("Reed-Solomon decoding failed");
         return;
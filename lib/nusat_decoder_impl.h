@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include <array>
+#include <memory>
 
 #include "rs.h"
 
@@ -32,7 +33,7 @@ private:
     constexpr static size_t d_crc_byte = 1;
     static const uint8_t d_scrambler_sequence[];
     static const uint_fast8_t crc8_table[];
-    void* d_rs;
+    std::shared_ptr<void> d_rs;
     std::array<uint8_t, MAX_FRAME_LEN> d_data;
 
     uint_fast8_t crc8(const uint8_t* data, size_t data_len);
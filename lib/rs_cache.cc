@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "rs_cache.h"
+
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+extern "C" {
+#include "libfec/fec.h"
+}
+
+namespace gr {
+namespace satellites {
+
+std::shared_ptr<void> get_rs_char(int symsize, int gfpoly, int fcr, int prim, int nroots)
+{
+    using key_t = std::tuple<int, int, int, int, int>;
+    static std::mutex mutex;
+    static std::map<key_t, std::weak_ptr<void>> cache;
+
+    const key_t key{ symsize, gfpoly, fcr, prim, nroots };
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        if (auto rs = it->second.lock()) {
+            return rs;
+        }
+    }
+
+    // Drop the entries of the codecs that have been freed
+    for (auto entry = cache.begin(); entry != cache.end();) {
+        entry = entry->second.expired() ? cache.erase(entry) : std::next(entry);
+    }
+
+    void* p = init_rs_char(symsize, gfpoly, fcr, prim, nroots, 0);
+    if (!p) {
+        return nullptr;
+    }
+    std::shared_ptr<void> rs(p, free_rs_char);
+    cache[key] = rs;
+    return rs;
+}
+
+} // namespace satellites
+} // namespace gr
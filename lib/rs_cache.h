@@ -0,0 +1,36 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_RS_CACHE_H
+#define INCLUDED_SATELLITES_RS_CACHE_H
+
+#include <memory>
+
+namespace gr {
+namespace satellites {
+
+/*!
+ * \brief Returns a Reed-Solomon codec from the process-wide cache
+ *
+ * The codec is the control block that init_rs_char() returns for the given
+ * parameters with no padding. Codecs are shared by all the blocks that use
+ * the same parameters and freed when the last of them is destroyed. The
+ * encode_rs_char() and decode_rs_char() functions do not modify the codec,
+ * so it can be used from several threads concurrently. Returns nullptr if
+ * the parameters are invalid.
+ *
+ * This function is thread-safe.
+ */
+std::shared_ptr<void> get_rs_char(int symsize, int gfpoly, int fcr, int prim, int nroots);
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_RS_CACHE_H */
@@ -49,15 +49,15 @@ u482c_decode_impl::u482c_decode_impl(bool verbose, int viterbi, int scrambler, i
                 gr::io_signature::make(0, 0, 0),
                 gr::io_signature::make(0, 0, 0)),
       d_verbose(verbose),
+      d_vp(nullptr),
       d_viterbi(viterbi),
       d_scrambler(scrambler),
       d_rs(rs)
 {
     // init FEC
     if (d_viterbi != OFF) {
-        int16_t polys[2] = { V27POLYA, V27POLYB };
-        set_viterbi_polynomial_packed(polys);
-        d_vp = create_viterbi_packed(d_rs_len * 8);
+        const int16_t polys[2] = { V27POLYA, V27POLYB };
+        d_vp = create_viterbi_packed(polys, d_rs_len * 8);
         if (!d_vp)
             throw std::bad_alloc();
     }
@@ -76,8 +76,7 @@ u482c_decode_impl::u482c_decode_impl(bool verbose, int viterbi, int scrambler, i
  */
 u482c_decode_impl::~u482c_decode_impl()
 {
-    if (d_vp)
-        delete_viterbi_packed(d_vp);
+    delete_viterbi_packed(d_vp);
 }
 
 void u482c_decode_impl::forecast(int noutput_items, gr_vector_int& ninput_items_required)
@@ -19,6 +19,9 @@
 
 #include <array>
 
+// Viterbi decoder instance from viterbi.h
+struct v27;
+
 namespace gr {
 namespace satellites {
 
@@ -30,7 +33,7 @@ private:
     const bool d_verbose;
     std::array<char, d_rs_len> d_ccsds_sequence;
     std::array<uint8_t, d_header_len + d_rs_len> d_data;
-    void* d_vp;
+    struct v27* d_vp;
     const int d_viterbi;
     const int d_scrambler;
     const int d_rs;
@@ -14,8 +14,9 @@
 
 #include "varlen_packet_tagger_impl.h"
 #include <gnuradio/io_signature.h>
+#include <algorithm>
 #include <cstdio>
-#include <iostream>
+#include <cstring>
 extern "C" {
 #include "golay24.h"
 #include "libfec/fec.h"
@@ -29,10 +30,16 @@ varlen_packet_tagger::sptr varlen_packet_tagger::make(const std::string& sync_ke
                                                       int length_field_size,
                                                       int max_packet_size,
                                                       endianness_t endianness,
-                                                      bool use_golay)
+                                                      bool use_golay,
+                                                      bool packed)
 {
-    return gnuradio::make_block_sptr<varlen_packet_tagger_impl>(
-        sync_key, packet_key, length_field_size, max_packet_size, endianness, use_golay);
+    return gnuradio::make_block_sptr<varlen_packet_tagger_impl>(sync_key,
+                                                                packet_key,
+                                                                length_field_size,
+                                                                max_packet_size,
+                                                                endianness,
+                                                                use_golay,
+                                                                packed);
 }
 
 varlen_packet_tagger_impl::varlen_packet_tagger_impl(const std::string& sync_key,
@@ -40,7 +47,8 @@ varlen_packet_tagger_impl::varlen_packet_tagger_impl(const std::string& sync_key
                                                      int length_field_size,
                                                      int max_packet_size,
                                                      endianness_t endianness,
-                                                     bool use_golay)
+                                                     bool use_golay,
+                                                     bool packed)
     : gr::block("varlen_packet_tagger",
                 io_signature::make(1, 1, sizeof(char)),
                 io_signature::make(1, 1, sizeof(char))),
@@ -48,37 +56,77 @@ varlen_packet_tagger_impl::varlen_packet_tagger_impl(const std::string& sync_key
       d_mtu(max_packet_size),
       d_use_golay(use_golay),
       d_endianness(endianness),
-      d_have_sync(false)
+      d_bits_per_item(packed ? 8 : 1),
+      d_tag_search_offset(0),
+      d_next_sync(0),
+      d_ninput_items_required(1)
 {
     d_sync_tag = pmt::string_to_symbol(sync_key);
     d_packet_tag = pmt::string_to_symbol(packet_key);
-    d_ninput_items_required = d_header_length + 1;
 
     set_tag_propagation_policy(TPP_DONT);
 
     if (d_use_golay)
         d_header_length = 24;
+
+    // Any packet fits in the output buffer
+    set_min_noutput_items(std::max(items_for_bits(d_mtu), 1));
 }
 
 
 varlen_packet_tagger_impl::~varlen_packet_tagger_impl() {}
 
+int varlen_packet_tagger_impl::get_bit(const unsigned char* in, int bit) const
+{
+    if (d_bits_per_item == 1) {
+        return in[bit];
+    }
+    return (in[bit / 8] >> (7 - bit % 8)) & 1;
+}
+
+int varlen_packet_tagger_impl::items_for_bits(int bits) const
+{
+    return (bits + d_bits_per_item - 1) / d_bits_per_item;
+}
+
 int varlen_packet_tagger_impl::bits2len(const unsigned char* in)
 {
     // extract the packet length from the header
     int ret = 0;
     if (d_endianness == GR_MSB_FIRST) {
         for (int i = 0; i < d_header_length; i++) {
-            ret = (ret << 0x01) + in[i];
+            ret = (ret << 0x01) + get_bit(in, i);
         }
     } else {
         for (int i = d_header_length - 1; i >= 0; i--) {
-            ret = (ret << 0x01) + in[i];
+            ret = (ret << 0x01) + get_bit(in, i);
         }
     }
     return ret;
 }
 
+void varlen_packet_tagger_impl::copy_packet(const unsigned char* in,
+                                            int packet_len,
+                                            unsigned char* out) const
+{
+    if (d_bits_per_item == 1) {
+        memcpy(out, &in[d_header_length], packet_len);
+        return;
+    }
+
+    // The packet starts at bit d_header_length % 8 of a byte
+    const unsigned char* packet = &in[d_header_length / 8];
+    const int shift = d_header_length % 8;
+    const int nbytes = packet_len / 8;
+    if (shift == 0) {
+        memcpy(out, packet, nbytes);
+        return;
+    }
+    for (int j = 0; j < nbytes; ++j) {
+        out[j] = (packet[j] << shift) | (packet[j + 1] >> (8 - shift));
+    }
+}
+
 void varlen_packet_tagger_impl::forecast(int noutput_items,
                                          gr_vector_int& ninput_items_required)
 {
@@ -94,90 +142,103 @@ int varlen_packet_tagger_impl::general_work(int noutput_items,
 {
     const unsigned char* in = (const unsigned char*)input_items[0];
     unsigned char* out = (unsigned char*)output_items[0];
-    int packet_len = 0;
-    std::vector<tag_t> tags;
-
-    uint32_t golay_field;
-    int golay_res = 0;
+    const uint64_t window_start = nitems_read(0);
+    const uint64_t window_end = window_start + ninput_items[0];
+
+    // Queue the sync tags that have not been seen yet
+    get_tags_in_range(d_tags,
+                      0,
+                      std::max(d_tag_search_offset, window_start),
+                      window_end,
+                      d_sync_tag);
+    std::sort(d_tags.begin(), d_tags.end(), [](const tag_t& a, const tag_t& b) {
+        return a.offset < b.offset;
+    });
+    for (const auto& tag : d_tags) {
+        d_syncs.push_back(tag.offset);
+    }
+    d_tag_search_offset = window_end;
+
+    int produced = 0;
+    d_ninput_items_required = 1;
+    while (!d_syncs.empty()) {
+        const uint64_t sync = d_syncs.front();
+        if (sync < d_next_sync) {
+            // Sync inside the header of the previous packet, or repeated
+            d_syncs.pop_front();
+            continue;
+        }
 
-    if (d_have_sync) {
-        if (d_header_length > ninput_items[0]) {
+        const unsigned char* header = &in[sync - window_start];
+        const int available = window_end - sync;
+        const int header_items = items_for_bits(d_header_length);
+        if (header_items > available) {
             // not enough data yet
-            return 0;
+            d_ninput_items_required = header_items;
+            break;
         }
 
+        int packet_len;
+        uint32_t golay_field;
+        int golay_res = 0;
         if (d_use_golay) {
-            golay_field = bits2len(in);
+            golay_field = bits2len(header);
             golay_res = decode_golay24(&golay_field);
-            if (golay_res >= 0) {
-                packet_len = 8 * (0xFFF & golay_field);
-            } else {
+            if (golay_res < 0) {
                 d_debug_logger->warn("Golay decode failed.");
-                d_have_sync = false;
-                consume_each(1); // skip ahead
-                return 0;
+                d_next_sync = sync + 1;
+                d_syncs.pop_front();
+                continue;
             }
-
+            packet_len = 8 * (0xFFF & golay_field);
         } else {
-            packet_len = 8 * bits2len(in);
+            packet_len = 8 * bits2len(header);
         }
 
         if (packet_len > d_mtu) {
             d_debug_logger->warn("Packet length {:d} > mtu {:d}.", packet_len, d_mtu);
-            d_have_sync = false;
-            consume_each(1); // skip ahead
-            return 0;
+            d_next_sync = sync + 1;
+            d_syncs.pop_front();
+            continue;
         }
 
-        d_ninput_items_required = d_header_length + packet_len;
-
-        if (noutput_items < packet_len) {
-            set_min_noutput_items(packet_len);
-            return 0;
+        const int packet_items = packet_len / d_bits_per_item;
+        const int total_items = items_for_bits(d_header_length + packet_len);
+        if (total_items > available) {
+            // not enough data yet
+            d_ninput_items_required = total_items;
+            break;
         }
-        set_min_noutput_items(1);
-
-        if (ninput_items[0] >= packet_len + d_header_length) {
-
-            if (d_use_golay) {
-                d_debug_logger->debug("Header: {#06x}, Len: {:d}",
-                                      0xFFFFFF & golay_field,
-                                      0xFFF & packet_len);
-                if (golay_res >= 0) {
-                    d_debug_logger->debug("Golay decoded. Errors: {:d}, Length: {:d}",
-                                          golay_res,
-                                          packet_len);
-                }
-            }
-
-            memcpy(out, &in[d_header_length], packet_len);
-            add_item_tag(0,
-                         nitems_written(0),
-                         d_packet_tag,
-                         pmt::from_long(packet_len),
-                         alias_pmt());
-            d_have_sync = false;
-
-            // consuming only the header allows for
-            // ... multiple syncs per 'packet',
-            // ... in case the sync was incorrectly tagged
-            consume_each(d_header_length);
-            d_ninput_items_required = d_header_length + 1;
-            return packet_len;
+        if (produced + packet_items > noutput_items) {
+            // the packet goes in the next call
+            break;
         }
 
-    } else {
-        // find the next sync tag, drop all other data
-        get_tags_in_range(
-            tags, 0, nitems_read(0), nitems_read(0) + ninput_items[0], d_sync_tag);
-        if (tags.size() > 0) {
-            d_have_sync = true;
-            consume_each(tags[0].offset - nitems_read(0));
-        } else {
-            consume_each(ninput_items[0]);
+        if (d_use_golay) {
+            d_debug_logger->debug(
+                "Header: {#06x}, Len: {:d}", 0xFFFFFF & golay_field, 0xFFF & packet_len);
+            d_debug_logger->debug(
+                "Golay decoded. Errors: {:d}, Length: {:d}", golay_res, packet_len);
         }
+
+        copy_packet(header, packet_len, &out[produced]);
+        add_item_tag(0,
+                     nitems_written(0) + produced,
+                     d_packet_tag,
+                     pmt::from_long(packet_items),
+                     alias_pmt());
+        produced += packet_items;
+
+        // skipping only the header allows for
+        // ... multiple syncs per 'packet',
+        // ... in case the sync was incorrectly tagged
+        d_next_sync = sync + header_items;
+        d_syncs.pop_front();
     }
-    return 0;
+
+    // Keep the input from the first pending sync onwards
+    consume_each(d_syncs.empty() ? ninput_items[0] : d_syncs.front() - window_start);
+    return produced;
 }
 
 } /* namespace satellites */
@@ -14,6 +14,9 @@
 #include <pmt/pmt.h>
 #include <satellites/varlen_packet_tagger.h>
 
+#include <deque>
+#include <vector>
+
 
 namespace gr {
 namespace satellites {
@@ -24,14 +27,23 @@ private:
     int d_mtu;                 // maximum packet size in bits
     bool d_use_golay;          // decode golay packet length
     endianness_t d_endianness; // header endianness
+    int d_bits_per_item;       // 8 for packed bytes, 1 for unpacked bits
 
     pmt::pmt_t d_sync_tag;   // marker tag on input for start of packet
     pmt::pmt_t d_packet_tag; // packet_len tag for output stream
 
-    bool d_have_sync;            // interal state
-    int d_ninput_items_required; // forecast
+    // Sync tags not processed yet. The input is consumed only up to the
+    // first of them, so that it can wait for the rest of its packet.
+    std::deque<uint64_t> d_syncs;
+    std::vector<tag_t> d_tags;
+    uint64_t d_tag_search_offset; // sync tags before this have been queued
+    uint64_t d_next_sync;         // sync tags before this are ignored
+    int d_ninput_items_required;  // forecast
 
     int bits2len(const unsigned char* in);
+    int get_bit(const unsigned char* in, int bit) const;
+    int items_for_bits(int bits) const;
+    void copy_packet(const unsigned char* in, int packet_len, unsigned char* out) const;
 
 public:
     varlen_packet_tagger_impl(const std::string& sync_key,
@@ -39,7 +51,8 @@ public:
                               int length_field_size,
                               int max_packet_size,
                               endianness_t endianness,
-                              bool use_golay);
+                              bool use_golay,
+                              bool packed);
     ~varlen_packet_tagger_impl();
 
     void forecast(int noutput_items, gr_vector_int& ninput_itens_required);
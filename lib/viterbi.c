@@ -13,6 +13,21 @@
 
 #include "viterbi.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VITERBI_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(VITERBI_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VITERBI_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define VITERBI_NEON
+#include <arm_neon.h>
+#endif
+
 #ifndef BITS_PER_BYTE
 #define BITS_PER_BYTE 8
 #endif
@@ -42,74 +57,46 @@ typedef union {
 
 /* We use the CCSDS convention
  * (see CCSDS 131.0-B-2 TM Synchronization and Channel Coding p3-2) */
-static int16_t polys[2] = { V27POLYB, -V27POLYA };
-static bool init = false;
+static const int16_t default_polys[2] = { V27POLYB, -V27POLYA };
 
-static uint8_t partab[256];
-static bool p_init;
+/* Add-compare-select kernel processing nbits trellis steps */
+typedef void (*update_kernel_t)(struct v27* vp, const uint8_t* syms, uint16_t nbits);
 
-/* State info for Viterbi decoder instance */
+/* State info for Viterbi decoder instance. Each instance owns its
+ * polynomials and branch tables, so that several instances can be used
+ * concurrently from different threads. */
 struct v27 {
-    metric_t metrics1; /* path metric buffer 1 */
-    metric_t metrics2; /* path metric buffer 2 */
-    decision_t* dp;    /* Pointer to current decision */
+    metric_t metrics1;        /* path metric buffer 1 */
+    metric_t metrics2;        /* path metric buffer 2 */
+    decision_t* dp;           /* Pointer to current decision */
     metric_t *old_metrics,
-        *new_metrics;      /* Pointers to path metrics, swapped on every bit */
-    decision_t* decisions; /* Beginning of decisions for block */
-    uint16_t dlen;         /* Length of decisions array for block */
+        *new_metrics;         /* Pointers to path metrics, swapped on every bit */
+    decision_t* decisions;    /* Beginning of decisions for block */
+    uint16_t dlen;            /* Length of decisions array for block */
+    int16_t polys[2];         /* Polynomials in use */
+    branchtab_t branchtab[2]; /* Branch tables for the polynomials */
+    branchtab_t metrics[4];   /* Branch metrics for each pair of symbols */
+    update_kernel_t update;   /* Kernel selected for this CPU */
 };
 
-static branchtab_t branchtab[2];
-static struct v27 v27_local;
-static decision_t decisions_local;
-
-/* Create 256-entry odd-parity lookup table */
-static void partab_init(void)
-{
-    int i, cnt, ti;
-
-    /* Initialize parity lookup table */
-    for (i = 0; i < 256; i++) {
-        cnt = 0;
-        ti = i;
-        while (ti) {
-            if (ti & 1)
-                cnt++;
-            ti >>= 1;
-        }
-        partab[i] = cnt & 1;
-    }
-
-    p_init = true;
-}
-
-static inline int parityb(unsigned char x)
-{
-    extern uint8_t partab[256];
-    extern bool p_init;
-
-    if (!p_init)
-        partab_init();
-
-    return partab[x];
-}
+static update_kernel_t select_update_kernel(void);
 
 static inline int parity(uint32_t x)
 {
-    /* Fold down to one byte */
+    /* Fold down to one nibble and look it up in a 16-bit constant */
     x ^= (x >> 16);
     x ^= (x >> 8);
+    x ^= (x >> 4);
 
-    return parityb(x);
+    return (0x6996 >> (x & 0xf)) & 1;
 }
 
 /* Initialize Viterbi decoder for start of new frame */
-int init_viterbi_packed(void* p, int starting_state)
+int init_viterbi_packed(struct v27* vp, int starting_state)
 {
-    struct v27* vp = p;
     int i;
 
-    if (p == NULL)
+    if (vp == NULL)
         return -1;
 
     for (i = 0; i < 64; i++)
@@ -123,32 +110,41 @@ int init_viterbi_packed(void* p, int starting_state)
     return 0;
 }
 
-void set_viterbi_polynomial_packed(int16_t polys[2])
+void set_viterbi_polynomial_packed(struct v27* vp, const int16_t polys[2])
 {
     int state;
 
+    vp->polys[0] = polys[0];
+    vp->polys[1] = polys[1];
     for (state = 0; state < 32; state++) {
-        branchtab[0].c[state] =
+        vp->branchtab[0].c[state] =
             (polys[0] < 0) ^ parity((2 * state) & abs(polys[0])) ? 1 : 0;
-        branchtab[1].c[state] =
+        vp->branchtab[1].c[state] =
             (polys[1] < 0) ^ parity((2 * state) & abs(polys[1])) ? 1 : 0;
+        /* The index is sym0 << 1 | sym1 */
+        for (int sym = 0; sym < 4; sym++) {
+            vp->metrics[sym].c[state] = (vp->branchtab[0].c[state] ^ (sym >> 1)) +
+                                        (vp->branchtab[1].c[state] ^ (sym & 1));
+        }
     }
-
-    init = true;
 }
 
 /* Create a new instance of a Viterbi decoder */
-void* create_viterbi_packed(int16_t len)
+struct v27* create_viterbi_packed(const int16_t polys[2], int16_t len)
 {
-    /* Keep state in internal RAM */
-    struct v27* vp = &v27_local;
+    struct v27* vp = malloc(sizeof(struct v27));
+
+    if (vp == NULL)
+        return NULL;
 
-    if (!init)
-        set_viterbi_polynomial_packed(polys);
+    set_viterbi_polynomial_packed(vp, polys != NULL ? polys : default_polys);
+    vp->update = select_update_kernel();
 
     vp->dlen = (len + 6) * sizeof(decision_t);
-    if ((vp->decisions = malloc(vp->dlen)) == NULL)
+    if ((vp->decisions = malloc(vp->dlen)) == NULL) {
+        free(vp);
         return NULL;
+    }
 
     init_viterbi_packed(vp, 0);
 
@@ -156,19 +152,20 @@ void* create_viterbi_packed(int16_t len)
 }
 
 /* Viterbi chainback */
-int chainback_viterbi_packed(void* p,
+int chainback_viterbi_packed(struct v27* vp,
                              unsigned char* data,
                              unsigned int nbits,
                              unsigned int endstate)
 {
     int k;
-    struct v27* vp = p;
     decision_t* d;
-    int errors = vp->old_metrics->w[endstate];
+    int errors;
 
-    if (unlikely(p == NULL))
+    if (unlikely(vp == NULL))
         return -1;
 
+    errors = vp->old_metrics->w[endstate % 64];
+
     d = vp->decisions;
 
     /* Make room beyond the end of the encoder register so we can
@@ -190,18 +187,20 @@ int chainback_viterbi_packed(void* p,
 }
 
 /* Delete instance of a Viterbi decoder */
-void delete_viterbi_packed(void* p)
+void delete_viterbi_packed(struct v27* vp)
 {
-    struct v27* vp = p;
+    if (vp == NULL)
+        return;
 
     if (vp->decisions != NULL)
         free((void*)vp->decisions);
+    free(vp);
 }
 
 /* C-language butterfly */
 #define BFLY(b)                                                           \
     do {                                                                  \
-        metric = (branchtab[0].c[b] ^ sym0) + (branchtab[1].c[b] ^ sym1); \
+        metric = (bt0[b] ^ sym0) + (bt1[b] ^ sym1);                       \
                                                                           \
         m0 = vp->old_metrics->w[b] + metric;                              \
         m1 = vp->old_metrics->w[b + 32] + (2 - metric);                   \
@@ -216,23 +215,18 @@ void delete_viterbi_packed(void* p)
         d->w[b >> 2] |= decision << (((b << 1) + 1) & 7);                 \
     } while (0)
 
-/*
- * Update decoder with a block of demodulated symbols
- * Note that nbits is the number of decoded data bits, not the number
- * of symbols!
- */
-int update_viterbi_packed(void* p, uint8_t* syms, uint16_t nbits)
+#if !defined(VITERBI_SSE2) && !defined(VITERBI_NEON)
+static void update_port(struct v27* vp, const uint8_t* syms, uint16_t nbits)
 {
-    struct v27* vp = p;
-    void* tmp;
-    decision_t *dp, *d = &decisions_local;
-    uint16_t i = 0;
+    metric_t* tmp;
+    decision_t *dp, decision_cache, *d = &decision_cache;
+    const uint8_t *bt0, *bt1;
+    uint32_t i = 0;
     uint8_t m0, m1, decision, metric, sym0, sym1;
 
-    if (unlikely(p == NULL))
-        return -1;
-
     dp = vp->dp;
+    bt0 = vp->branchtab[0].c;
+    bt1 = vp->branchtab[1].c;
 
     while (likely(nbits--)) {
         /* Cache decisions in internal memory */
@@ -286,12 +280,199 @@ int update_viterbi_packed(void* p, uint8_t* syms, uint16_t nbits)
         vp->new_metrics = tmp;
     }
 
-    vp->dp = d;
+    vp->dp = dp;
+}
+#endif
+
+/*
+ * Vectorized butterflies. The metrics are added with the same 8-bit
+ * wrapping arithmetic as the C-language butterflies, and the decision for
+ * each new state is m0 > m1, which is computed as min(m0, m1) != m0. The
+ * new metrics and decisions of butterfly b go to states 2 * b and
+ * 2 * b + 1, so the results for both states are interleaved.
+ */
+#ifdef VITERBI_SSE2
+static void update_sse2(struct v27* vp, const uint8_t* syms, uint16_t nbits)
+{
+    metric_t* tmp;
+    decision_t* dp = vp->dp;
+    uint32_t i = 0;
+    const __m128i two = _mm_set1_epi8(2);
+
+    while (likely(nbits--)) {
+        const int sym = (get_bit(syms, i) << 1) | get_bit(syms, i + 1);
+        const uint8_t* old_m = vp->old_metrics->w;
+        uint8_t* new_m = vp->new_metrics->w;
+        uint16_t d[4];
+        i += 2;
+
+        for (int h = 0; h < 2; h++) {
+            const __m128i bm =
+                _mm_loadu_si128((const __m128i*)&vp->metrics[sym].c[16 * h]);
+            const __m128i bmc = _mm_sub_epi8(two, bm);
+            const __m128i a = _mm_loadu_si128((const __m128i*)&old_m[16 * h]);
+            const __m128i c = _mm_loadu_si128((const __m128i*)&old_m[32 + 16 * h]);
+            const __m128i m0 = _mm_add_epi8(a, bm);
+            const __m128i m1 = _mm_add_epi8(c, bmc);
+            const __m128i m2 = _mm_add_epi8(a, bmc);
+            const __m128i m3 = _mm_add_epi8(c, bm);
+            const __m128i even = _mm_min_epu8(m0, m1);
+            const __m128i odd = _mm_min_epu8(m2, m3);
+            /* These are the negated decisions */
+            const __m128i even_d = _mm_cmpeq_epi8(even, m0);
+            const __m128i odd_d = _mm_cmpeq_epi8(odd, m2);
+            _mm_storeu_si128((__m128i*)&new_m[32 * h], _mm_unpacklo_epi8(even, odd));
+            _mm_storeu_si128((__m128i*)&new_m[32 * h + 16], _mm_unpackhi_epi8(even, odd));
+            d[2 * h] = ~_mm_movemask_epi8(_mm_unpacklo_epi8(even_d, odd_d));
+            d[2 * h + 1] = ~_mm_movemask_epi8(_mm_unpackhi_epi8(even_d, odd_d));
+        }
+        memcpy(dp++, d, sizeof(decision_t));
+
+        tmp = vp->old_metrics;
+        vp->old_metrics = vp->new_metrics;
+        vp->new_metrics = tmp;
+    }
+
+    vp->dp = dp;
+}
+#endif
+
+#ifdef VITERBI_AVX2
+__attribute__((target("avx2"))) static void
+update_avx2(struct v27* vp, const uint8_t* syms, uint16_t nbits)
+{
+    metric_t* tmp;
+    decision_t* dp = vp->dp;
+    uint32_t i = 0;
+    const __m256i two = _mm256_set1_epi8(2);
+
+    while (likely(nbits--)) {
+        const int sym = (get_bit(syms, i) << 1) | get_bit(syms, i + 1);
+        const uint8_t* old_m = vp->old_metrics->w;
+        uint8_t* new_m = vp->new_metrics->w;
+        i += 2;
+
+        const __m256i bm = _mm256_loadu_si256((const __m256i*)vp->metrics[sym].c);
+        const __m256i bmc = _mm256_sub_epi8(two, bm);
+        const __m256i a = _mm256_loadu_si256((const __m256i*)&old_m[0]);
+        const __m256i c = _mm256_loadu_si256((const __m256i*)&old_m[32]);
+        const __m256i m0 = _mm256_add_epi8(a, bm);
+        const __m256i m1 = _mm256_add_epi8(c, bmc);
+        const __m256i m2 = _mm256_add_epi8(a, bmc);
+        const __m256i m3 = _mm256_add_epi8(c, bm);
+        const __m256i even = _mm256_min_epu8(m0, m1);
+        const __m256i odd = _mm256_min_epu8(m2, m3);
+        const __m256i even_d = _mm256_cmpeq_epi8(even, m0);
+        const __m256i odd_d = _mm256_cmpeq_epi8(odd, m2);
+
+        /* unpack works within each 128-bit lane, so the lanes need to be
+         * reordered to get the states in order */
+        const __m256i lo = _mm256_unpacklo_epi8(even, odd);
+        const __m256i hi = _mm256_unpackhi_epi8(even, odd);
+        _mm256_storeu_si256((__m256i*)&new_m[0], _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i*)&new_m[32],
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+
+        const __m256i lo_d = _mm256_unpacklo_epi8(even_d, odd_d);
+        const __m256i hi_d = _mm256_unpackhi_epi8(even_d, odd_d);
+        const uint32_t d[2] = {
+            ~(uint32_t)_mm256_movemask_epi8(_mm256_permute2x128_si256(lo_d, hi_d, 0x20)),
+            ~(uint32_t)_mm256_movemask_epi8(_mm256_permute2x128_si256(lo_d, hi_d, 0x31))
+        };
+        memcpy(dp++, d, sizeof(decision_t));
+
+        tmp = vp->old_metrics;
+        vp->old_metrics = vp->new_metrics;
+        vp->new_metrics = tmp;
+    }
+
+    vp->dp = dp;
+}
+#endif
+
+#ifdef VITERBI_NEON
+static void update_neon(struct v27* vp, const uint8_t* syms, uint16_t nbits)
+{
+    metric_t* tmp;
+    decision_t* dp = vp->dp;
+    uint32_t i = 0;
+    const uint8x16_t two = vdupq_n_u8(2);
+    static const uint8_t bit_weights[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                             1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t weights = vld1q_u8(bit_weights);
+
+    while (likely(nbits--)) {
+        const int sym = (get_bit(syms, i) << 1) | get_bit(syms, i + 1);
+        const uint8_t* old_m = vp->old_metrics->w;
+        uint8_t* new_m = vp->new_metrics->w;
+        i += 2;
+
+        for (int h = 0; h < 2; h++) {
+            const uint8x16_t bm = vld1q_u8(&vp->metrics[sym].c[16 * h]);
+            const uint8x16_t bmc = vsubq_u8(two, bm);
+            const uint8x16_t a = vld1q_u8(&old_m[16 * h]);
+            const uint8x16_t c = vld1q_u8(&old_m[32 + 16 * h]);
+            const uint8x16_t m0 = vaddq_u8(a, bm);
+            const uint8x16_t m1 = vaddq_u8(c, bmc);
+            const uint8x16_t m2 = vaddq_u8(a, bmc);
+            const uint8x16_t m3 = vaddq_u8(c, bm);
+            const uint8x16x2_t states = vzipq_u8(vminq_u8(m0, m1), vminq_u8(m2, m3));
+            const uint8x16x2_t d = vzipq_u8(vcgtq_u8(m0, m1), vcgtq_u8(m2, m3));
+            vst1q_u8(&new_m[32 * h], states.val[0]);
+            vst1q_u8(&new_m[32 * h + 16], states.val[1]);
+            for (int k = 0; k < 2; k++) {
+                const uint8x16_t bits = vandq_u8(d.val[k], weights);
+                dp->w[4 * h + 2 * k] = vaddv_u8(vget_low_u8(bits));
+                dp->w[4 * h + 2 * k + 1] = vaddv_u8(vget_high_u8(bits));
+            }
+        }
+        dp++;
+
+        tmp = vp->old_metrics;
+        vp->old_metrics = vp->new_metrics;
+        vp->new_metrics = tmp;
+    }
+
+    vp->dp = dp;
+}
+#endif
+
+static update_kernel_t select_update_kernel(void)
+{
+#ifdef VITERBI_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return update_avx2;
+#endif
+#if defined(VITERBI_SSE2)
+    return update_sse2;
+#elif defined(VITERBI_NEON)
+    return update_neon;
+#else
+    return update_port;
+#endif
+}
+
+/*
+ * Update decoder with a block of demodulated symbols
+ * Note that nbits is the number of decoded data bits, not the number
+ * of symbols!
+ */
+int update_viterbi_packed(struct v27* vp, const uint8_t* syms, uint16_t nbits)
+{
+    if (unlikely(vp == NULL))
+        return -1;
+
+    vp->update(vp, syms, nbits);
     return 0;
 }
 
-void encode_viterbi_packed(unsigned char* channel, unsigned char* data, int framebits)
+void encode_viterbi_packed(const struct v27* vp,
+                           unsigned char* channel,
+                           const unsigned char* data,
+                           int framebits)
 {
+    const int16_t* polys = vp->polys;
     int i;
     unsigned char bit;
     unsigned char in_sr = 0;
@@ -20,15 +20,26 @@
 #define V27POLYA 0x6d
 #define V27POLYB 0x4f
 
-void* create_viterbi_packed(int16_t len);
-int init_viterbi_packed(void* vp, int starting_state);
-int update_viterbi_packed(void* vp, unsigned char sym[], uint16_t npairs);
-int chainback_viterbi_packed(void* vp,
+/* Opaque Viterbi decoder instance. Each instance owns its polynomials,
+ * branch tables and decisions, so different instances can be used
+ * concurrently from different threads. */
+struct v27;
+
+/* Creates a decoder for frames of up to len bits. If polys is NULL, the
+ * CCSDS polynomials { V27POLYB, -V27POLYA } are used. A negative
+ * polynomial means that its output is inverted. */
+struct v27* create_viterbi_packed(const int16_t polys[2], int16_t len);
+int init_viterbi_packed(struct v27* vp, int starting_state);
+int update_viterbi_packed(struct v27* vp, const unsigned char sym[], uint16_t npairs);
+int chainback_viterbi_packed(struct v27* vp,
                              unsigned char* data,
                              unsigned int nbits,
                              unsigned int endstate);
-void delete_viterbi_packed(void* vp);
-void encode_viterbi_packed(unsigned char* channel, unsigned char* data, int framebits);
-void set_viterbi_polynomial_packed(int16_t polys[2]);
+void delete_viterbi_packed(struct v27* vp);
+void encode_viterbi_packed(const struct v27* vp,
+                           unsigned char* channel,
+                           const unsigned char* data,
+                           int framebits);
+void set_viterbi_polynomial_packed(struct v27* vp, const int16_t polys[2]);
 
 #endif // VITERBI_H_
@@ -2,31 +2,22 @@
 //
 // Author: Min Xu <xukmin@gmail.com>
 // Date: 01/30/2015
+//
+// Modified for gr-satellites by Daniel Estevez <daniel@destevez.net>:
+// soft-decision decoding with vectorized add-compare-select and packed
+// decision bits.
 
 #include "viterbi.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
-#include <limits>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
-namespace {
-
-int HammingDistance(const std::string& x, const std::string& y)
-{
-    assert(x.size() == y.size());
-    int distance = 0;
-    for (int i = 0; i < (int)x.size(); i++) {
-        distance += x[i] != y[i];
-    }
-    return distance;
-}
-
-} // namespace
-
 std::ostream& operator<<(std::ostream& os, const ViterbiCodec& codec)
 {
     os << "ViterbiCodec(" << codec.constraint() << ", {";
@@ -50,19 +41,99 @@ int ReverseBits(int num_bits, int input)
     return output;
 }
 
-ViterbiCodec::ViterbiCodec(int constraint, const std::vector<int>& polynomials)
-    : constraint_(constraint), polynomials_(polynomials)
+constexpr int ViterbiCodec::kMaxConstraint;
+
+ViterbiCodec::ViterbiCodec(int constraint,
+                           const std::vector<int>& polynomials,
+                           int traceback_depth,
+                           const std::vector<int>& puncturing)
+    : constraint_(constraint),
+      polynomials_(polynomials),
+      traceback_depth_(traceback_depth),
+      puncturing_(puncturing)
 {
+    assert(constraint_ >= 2);
+    assert(constraint_ <= kMaxConstraint);
+    assert(traceback_depth_ >= 0);
     assert(!polynomials_.empty());
+    assert((int)polynomials_.size() <= viterbi_acs::kMaxParityBits);
     for (int i = 0; i < (int)polynomials_.size(); i++) {
         assert(polynomials_[i] > 0);
         assert(polynomials_[i] < (1 << constraint_));
     }
+    assert(ValidPuncturing(puncturing_, num_parity_bits()));
     InitializeOutputs();
+    InitializeBranchTables();
+    InitializeEncoderTables();
+    // Kernels specialized for the most common codes are preferred
+    kernel_ = viterbi_acs::select_fixed_kernel(constraint_, polynomials_);
+    if (kernel_ == nullptr) {
+        kernel_ = viterbi_acs::select_kernel(tables_);
+    }
+    batch_kernel_ = viterbi_acs::select_batch_kernel(tables_);
+
+    // Each branch metric is at most num_parity_bits() * symbol_max_ in
+    // absolute value, and the spread of the path metrics is bounded by the
+    // branch metrics of 2 * constraint_ steps (including the initial
+    // metric given to the states other than 0).
+    symbol_max_ = std::min(127, 32000 / (4 * constraint_ * num_parity_bits()));
 }
 
 int ViterbiCodec::num_parity_bits() const { return polynomials_.size(); }
 
+static int Parity(int x)
+{
+    int p = 0;
+    for (; x; x >>= 1) {
+        p ^= x & 1;
+    }
+    return p;
+}
+
+bool ViterbiCodec::ValidPuncturing(const std::vector<int>& puncturing,
+                                   int num_parity_bits)
+{
+    if (puncturing.empty()) {
+        return true;
+    }
+    if (puncturing.size() % num_parity_bits != 0) {
+        return false;
+    }
+    for (auto p : puncturing) {
+        if ((p != 0) && (p != 1)) {
+            return false;
+        }
+    }
+    return std::find(puncturing.begin(), puncturing.end(), 1) != puncturing.end();
+}
+
+void ViterbiCodec::CheckParameters(int constraint,
+                                   const std::vector<int>& polynomials,
+                                   int traceback_depth,
+                                   const std::vector<int>& puncturing)
+{
+    if ((constraint < 2) || (constraint > kMaxConstraint)) {
+        throw std::runtime_error("constraint must be between 2 and " +
+                                 std::to_string(kMaxConstraint));
+    }
+    if (polynomials.empty() ||
+        ((int)polynomials.size() > viterbi_acs::kMaxParityBits)) {
+        throw std::runtime_error("the number of polynomials must be between 1 and " +
+                                 std::to_string(viterbi_acs::kMaxParityBits));
+    }
+    for (auto p : polynomials) {
+        if ((p <= 0) || (p >= (1 << constraint))) {
+            throw std::runtime_error("invalid polynomial");
+        }
+    }
+    if (traceback_depth < 0) {
+        throw std::runtime_error("traceback_depth must be non-negative");
+    }
+    if (!ValidPuncturing(puncturing, polynomials.size())) {
+        throw std::runtime_error("invalid puncturing pattern");
+    }
+}
+
 int ViterbiCodec::NextState(int current_state, int input) const
 {
     return (current_state >> 1) | (input << (constraint_ - 2));
@@ -93,7 +164,75 @@ std::string ViterbiCodec::Encode(const std::string& bits) const
         state = NextState(state, 0);
     }
 
-    return encoded;
+    if (puncturing_.empty()) {
+        return encoded;
+    }
+
+    std::string punctured;
+    for (int i = 0; i < (int)encoded.size(); i++) {
+        if (puncturing_[i % puncturing_.size()]) {
+            punctured += encoded[i];
+        }
+    }
+    return punctured;
+}
+
+int ViterbiCodec::EncodePacked(const uint8_t* data,
+                               int num_bits,
+                               std::vector<uint8_t>* encoded) const
+{
+    const int n = num_parity_bits();
+    const int num_steps = num_bits + constraint_ - 1;
+    const int history_mask = (1 << (constraint_ - 1)) - 1;
+
+    int num_symbols = num_steps * n;
+    if (!puncturing_.empty()) {
+        const int period = puncturing_.size();
+        const int remaining = num_symbols % period;
+        num_symbols = (num_symbols / period) *
+                          std::count(puncturing_.begin(), puncturing_.end(), 1) +
+                      std::count(puncturing_.begin(), puncturing_.begin() + remaining, 1);
+    }
+    encoded->assign((num_symbols + 7) / 8, 0);
+    uint8_t* out = encoded->data();
+
+    // Previous (constraint_ - 1) input bits, with the newest in the LSB
+    int history = 0;
+    int step = 0;
+    int written = 0;
+
+    if (puncturing_.empty() && !byte_outputs_.empty()) {
+        // Each input byte produces exactly n output bytes
+        const int num_bytes = num_bits / 8;
+        for (int k = 0; k < num_bytes; k++) {
+            const uint64_t word = state_outputs_[history] ^ byte_outputs_[data[k]];
+            for (int b = n - 1; b >= 0; b--) {
+                *out++ = word >> (8 * b);
+            }
+            history = ((history << 8) | data[k]) & history_mask;
+        }
+        step = 8 * num_bytes;
+        written = 8 * n * num_bytes;
+    }
+
+    // Remaining bits and flushing bits, one at a time
+    long pos = written;
+    for (; step < num_steps; step++) {
+        const int input = step < num_bits ? (data[step / 8] >> (7 - step % 8)) & 1 : 0;
+        const int reg = (history << 1) | input;
+        const uint32_t symbols = register_outputs_[reg];
+        history = reg & history_mask;
+        for (int j = n - 1; j >= 0; j--, pos++) {
+            if (!puncturing_.empty() && !puncturing_[pos % puncturing_.size()]) {
+                continue;
+            }
+            (*encoded)[written / 8] |= ((symbols >> j) & 1) << (7 - written % 8);
+            written++;
+        }
+    }
+
+    assert(written == num_symbols);
+    return written;
 }
 
 void ViterbiCodec::InitializeOutputs()
@@ -115,85 +254,409 @@ void ViterbiCodec::InitializeOutputs()
     }
 }
 
-int ViterbiCodec::BranchMetric(const std::string& bits,
-                               int source_state,
-                               int target_state) const
+
+void ViterbiCodec::InitializeEncoderTables()
 {
-    assert(bits.size() == num_parity_bits());
-    assert((target_state & ((1 << (constraint_ - 2)) - 1)) == source_state >> 1);
-    const std::string output = Output(source_state, target_state >> (constraint_ - 2));
+    const int n = num_parity_bits();
+    const int register_mask = (1 << constraint_) - 1;
+
+    register_outputs_.resize(1 << constraint_);
+    for (int reg = 0; reg <= register_mask; reg++) {
+        uint32_t symbols = 0;
+        for (int j = 0; j < n; j++) {
+            symbols = (symbols << 1) | Parity(reg & polynomials_[j]);
+        }
+        register_outputs_[reg] = symbols;
+    }
 
-    return HammingDistance(bits, output);
+    // The symbols of a whole byte only fit in the 64-bit words for up to 8
+    // polynomials.
+    if (n > 8) {
+        return;
+    }
+    state_outputs_.resize(1 << (constraint_ - 1));
+    for (int history = 0; history < (int)state_outputs_.size(); history++) {
+        uint64_t word = 0;
+        for (int t = 0; t < 8; t++) {
+            word = (word << n) | register_outputs_[(history << (t + 1)) & register_mask];
+        }
+        state_outputs_[history] = word;
+    }
+    byte_outputs_.resize(256);
+    for (int byte = 0; byte < 256; byte++) {
+        uint64_t word = 0;
+        for (int t = 0; t < 8; t++) {
+            word = (word << n) | register_outputs_[(byte >> (7 - t)) & register_mask];
+        }
+        byte_outputs_[byte] = word;
+    }
 }
 
-std::pair<int, int> ViterbiCodec::PathMetric(const std::string& bits,
-                                             const std::vector<int>& prev_path_metrics,
-                                             int state) const
+void ViterbiCodec::InitializeBranchTables()
 {
-    int s = (state & ((1 << (constraint_ - 2)) - 1)) << 1;
-    int source_state1 = s | 0;
-    int source_state2 = s | 1;
+    const int n = num_parity_bits();
+    tables_.num_states = 1 << (constraint_ - 1);
+    tables_.num_butterflies = tables_.num_states / 2;
+    tables_.num_parity_bits = n;
+    tables_.words_per_step = std::max(1, tables_.num_butterflies / 8);
 
-    int pm1 = prev_path_metrics[source_state1];
-    if (pm1 < std::numeric_limits<int>::max()) {
-        pm1 += BranchMetric(bits, source_state1, state);
+    // If all the polynomials use the newest and the oldest bits of the shift
+    // register, flipping any of them flips all the parity bits.
+    tables_.symmetric = true;
+    for (int j = 0; j < n; j++) {
+        if (!(polynomials_[j] & 1) || !(polynomials_[j] & (1 << (constraint_ - 1)))) {
+            tables_.symmetric = false;
+        }
     }
-    int pm2 = prev_path_metrics[source_state2];
-    if (pm2 < std::numeric_limits<int>::max()) {
-        pm2 += BranchMetric(bits, source_state2, state);
+
+    const int h = tables_.num_butterflies;
+    const int num_branches = tables_.symmetric ? 1 : 4;
+    tables_.masks.assign(num_branches * n * h, 0);
+    tables_.codes.assign(num_branches * h, 0);
+    for (int b = 0; b < num_branches; b++) {
+        const int input = b & 1;
+        const int source_high = b >> 1;
+        for (int i = 0; i < h; i++) {
+            // Shift register contents with the newest bit in the LSB. The
+            // outputs_ table uses the opposite bit order.
+            const int reg = (((i + source_high * h) << 1) | input);
+            const std::string& output = outputs_[ReverseBits(constraint_, reg)];
+            for (int j = 0; j < n; j++) {
+                if (output[j] == '1') {
+                    tables_.masks[(b * n + j) * h + i] = -1;
+                    tables_.codes[b * h + i] |= 1U << j;
+                }
+            }
+        }
     }
+}
 
-    if (pm1 <= pm2) {
-        return std::make_pair(pm1, source_state1);
-    } else {
-        return std::make_pair(pm2, source_state2);
+int16_t ViterbiCodec::InitialMetric() const
+{
+    // The initial metric of the states other than 0 is large enough so that
+    // any path starting in them loses against the paths starting in state 0
+    // once all the states are reachable.
+    return 2 * (constraint_ - 1) * num_parity_bits() * symbol_max_ + 1;
+}
+
+void ViterbiCodec::Reset(int capacity)
+{
+    path_metrics_.assign(tables_.num_states, InitialMetric());
+    path_metrics_[0] = 0;
+    new_path_metrics_.resize(tables_.num_states);
+    decisions_capacity_ = std::max(capacity, 1);
+    decisions_.resize(decisions_capacity_ * tables_.words_per_step);
+    decisions_slot_ = 0;
+    num_steps_ = 0;
+    num_decided_ = 0;
+}
+
+void ViterbiCodec::UpdatePathMetrics(const int8_t* symbols)
+{
+    int16_t step_symbols[viterbi_acs::kMaxParityBits];
+    for (int j = 0; j < num_parity_bits(); j++) {
+        step_symbols[j] = std::max(-127, (int)symbols[j]) * symbol_max_ / 127;
     }
+    kernel_(tables_,
+            step_symbols,
+            path_metrics_.data(),
+            new_path_metrics_.data(),
+            &decisions_[decisions_slot_ * tables_.words_per_step]);
+    path_metrics_.swap(new_path_metrics_);
+    NextSlot();
 }
 
-void ViterbiCodec::UpdatePathMetrics(const std::string& bits,
-                                     std::vector<int>* path_metrics,
-                                     Trellis* trellis) const
+void ViterbiCodec::NextSlot()
 {
-    std::vector<int> new_path_metrics(path_metrics->size());
-    std::vector<int> new_trellis_column(1 << (constraint_ - 1));
-    for (int i = 0; i < (int)path_metrics->size(); i++) {
-        std::pair<int, int> p = PathMetric(bits, *path_metrics, i);
-        new_path_metrics[i] = p.first;
-        new_trellis_column[i] = p.second;
+    if (++decisions_slot_ == decisions_capacity_) {
+        decisions_slot_ = 0;
     }
+    num_steps_++;
+}
 
-    *path_metrics = new_path_metrics;
-    trellis->push_back(new_trellis_column);
+void ViterbiCodec::UpdatePathMetrics(const int8_t* symbols, int num_symbols)
+{
+    const int n = num_parity_bits();
+    const int num_full_steps = num_symbols / n;
+    for (int step = 0; step < num_full_steps; step++) {
+        UpdatePathMetrics(&symbols[step * n]);
+    }
+    const int remaining = num_symbols - num_full_steps * n;
+    if (remaining) {
+        // If some symbols are missing at the end, they are treated as
+        // erasures.
+        int8_t last_symbols[viterbi_acs::kMaxParityBits] = { 0 };
+        std::copy_n(&symbols[num_full_steps * n], remaining, last_symbols);
+        UpdatePathMetrics(last_symbols);
+    }
 }
 
-std::string ViterbiCodec::Decode(const std::string& bits) const
+void ViterbiCodec::Traceback(int num_skip, int num_out, uint8_t* decoded) const
 {
-    // Compute path metrics and generate trellis.
-    Trellis trellis;
-    std::vector<int> path_metrics(1 << (constraint_ - 1),
-                                  std::numeric_limits<int>::max());
-    path_metrics.front() = 0;
-    for (int i = 0; i < (int)bits.size(); i += num_parity_bits()) {
-        std::string current_bits(bits, i, num_parity_bits());
-        // If some bits are missing, fill with trailing zeros.
-        // This is not ideal but it is the best we can do.
-        if ((int)current_bits.size() < num_parity_bits()) {
-            current_bits.append(
-                std::string(num_parity_bits() - current_bits.size(), '0'));
+    const int words_per_step = tables_.words_per_step;
+    const int h = tables_.num_butterflies;
+
+    int state = std::min_element(path_metrics_.begin(), path_metrics_.end()) -
+                path_metrics_.begin();
+    int slot = decisions_slot_;
+    for (int step = num_skip + num_out - 1; step >= 0; step--) {
+        slot = (slot == 0 ? decisions_capacity_ : slot) - 1;
+        const int i = state >> 1;
+        const int input = state & 1;
+        const uint16_t word = decisions_[slot * words_per_step + (i >> 3)];
+        const int decision = (word >> (8 * input + (i & 7))) & 1;
+        if (step < num_out) {
+            decoded[step] = input;
         }
-        UpdatePathMetrics(current_bits, &path_metrics, &trellis);
+        state = i + decision * h;
     }
+}
 
-    // Traceback.
-    std::string decoded;
-    int state =
-        std::min_element(path_metrics.begin(), path_metrics.end()) - path_metrics.begin();
-    for (int i = trellis.size() - 1; i >= 0; i--) {
-        decoded += state >> (constraint_ - 2) ? "1" : "0";
-        state = trellis[i][state];
+void ViterbiCodec::ResetBatch(int capacity)
+{
+    constexpr int L = viterbi_acs::kBatchLanes;
+    batch_path_metrics_.assign(tables_.num_states * L, InitialMetric());
+    std::fill_n(batch_path_metrics_.begin(), L, 0);
+    batch_new_path_metrics_.resize(tables_.num_states * L);
+    batch_symbols_.resize(num_parity_bits() * L);
+    decisions_capacity_ = std::max(capacity, 1);
+    batch_decisions_.resize(decisions_capacity_ * tables_.num_states);
+    decisions_slot_ = 0;
+    num_steps_ = 0;
+    num_decided_ = 0;
+}
+
+void ViterbiCodec::UpdateBatchPathMetrics(const int8_t* const* symbols,
+                                          int num_lanes,
+                                          int num_symbols,
+                                          int step)
+{
+    constexpr int L = viterbi_acs::kBatchLanes;
+    const int n = num_parity_bits();
+    for (int j = 0; j < n; j++) {
+        const int k = step * n + j;
+        for (int l = 0; l < L; l++) {
+            const int symbol = (l < num_lanes && k < num_symbols) ? symbols[l][k] : 0;
+            batch_symbols_[j * L + l] = std::max(-127, symbol) * symbol_max_ / 127;
+        }
+    }
+    batch_kernel_(tables_,
+                  batch_symbols_.data(),
+                  batch_path_metrics_.data(),
+                  batch_new_path_metrics_.data(),
+                  &batch_decisions_[decisions_slot_ * tables_.num_states]);
+    batch_path_metrics_.swap(batch_new_path_metrics_);
+    NextSlot();
+}
+
+void ViterbiCodec::TracebackBatch(int lane,
+                                  int num_skip,
+                                  int num_out,
+                                  uint8_t* decoded) const
+{
+    constexpr int L = viterbi_acs::kBatchLanes;
+    const int num_states = tables_.num_states;
+    const int h = tables_.num_butterflies;
+
+    int state = 0;
+    for (int s = 1; s < num_states; s++) {
+        if (batch_path_metrics_[s * L + lane] < batch_path_metrics_[state * L + lane]) {
+            state = s;
+        }
+    }
+    int slot = decisions_slot_;
+    for (int step = num_skip + num_out - 1; step >= 0; step--) {
+        slot = (slot == 0 ? decisions_capacity_ : slot) - 1;
+        const int decision = (batch_decisions_[slot * num_states + state] >> lane) & 1;
+        if (step < num_out) {
+            decoded[step] = state & 1;
+        }
+        state = (state >> 1) + decision * h;
+    }
+}
+
+void ViterbiCodec::Depuncture(const int8_t* symbols,
+                              int num_symbols,
+                              std::vector<int8_t>* depunctured) const
+{
+    const int period = puncturing_.size();
+    depunctured->clear();
+    int pos = 0;
+    for (int i = 0; i < num_symbols; i++) {
+        while (!puncturing_[pos]) {
+            depunctured->push_back(0);
+            pos = (pos + 1) % period;
+        }
+        depunctured->push_back(symbols[i]);
+        pos = (pos + 1) % period;
+    }
+}
+
+void ViterbiCodec::ResetStream()
+{
+    assert(traceback_depth_ > 0);
+    Reset(2 * traceback_depth_);
+}
+
+int ViterbiCodec::DecodeStream(const int8_t* symbols, int num_steps, uint8_t* decoded)
+{
+    int num_out = 0;
+    for (int step = 0; step < num_steps; step++) {
+        UpdatePathMetrics(&symbols[step * num_parity_bits()]);
+        // When the decision buffer is full, the older half of it is decided
+        // by tracing back from the best state through the newer half.
+        if (num_steps_ - num_decided_ == 2 * traceback_depth_) {
+            Traceback(traceback_depth_, traceback_depth_, &decoded[num_out]);
+            num_out += traceback_depth_;
+            num_decided_ += traceback_depth_;
+        }
+    }
+    return num_out;
+}
+
+int ViterbiCodec::FlushStream(uint8_t* decoded)
+{
+    const int num_out = num_steps_ - num_decided_;
+    Traceback(0, num_out, decoded);
+    num_decided_ = num_steps_;
+    return num_out;
+}
+
+void ViterbiCodec::Decode(const int8_t* symbols,
+                          int num_symbols,
+                          std::vector<uint8_t>* decoded)
+{
+    if (!puncturing_.empty()) {
+        Depuncture(symbols, num_symbols, &depunctured_);
+        symbols = depunctured_.data();
+        num_symbols = depunctured_.size();
+    }
+
+    const int n = num_parity_bits();
+    const int num_steps = (num_symbols + n - 1) / n;
+    decoded->resize(num_steps);
+
+    if (traceback_depth_ == 0) {
+        Reset(num_steps);
+        UpdatePathMetrics(symbols, num_symbols);
+        Traceback(0, num_steps, decoded->data());
+    } else {
+        ResetStream();
+        const int num_full_steps = num_symbols / n;
+        int num_out = DecodeStream(symbols, num_full_steps, decoded->data());
+        UpdatePathMetrics(&symbols[num_full_steps * n], num_symbols - num_full_steps * n);
+        num_out += FlushStream(&(*decoded)[num_out]);
+        assert(num_out == num_steps);
     }
-    std::reverse(decoded.begin(), decoded.end());
 
     // Remove (constraint_ - 1) flushing bits.
-    return decoded.substr(0, decoded.size() - constraint_ + 1);
+    decoded->resize(std::max(0, num_steps - constraint_ + 1));
+}
+
+void ViterbiCodec::DecodeBatch(const int8_t* const* symbols,
+                               int num_codewords,
+                               int num_symbols,
+                               std::vector<std::vector<uint8_t>>* decoded)
+{
+    if (!puncturing_.empty() && (num_codewords > 0)) {
+        batch_depunctured_.resize(num_codewords);
+        batch_depunctured_pointers_.resize(num_codewords);
+        for (int k = 0; k < num_codewords; k++) {
+            Depuncture(symbols[k], num_symbols, &batch_depunctured_[k]);
+            batch_depunctured_pointers_[k] = batch_depunctured_[k].data();
+        }
+        symbols = batch_depunctured_pointers_.data();
+        num_symbols = batch_depunctured_[0].size();
+    }
+
+    constexpr int L = viterbi_acs::kBatchLanes;
+    const int n = num_parity_bits();
+    const int num_full_steps = num_symbols / n;
+    const int num_steps = (num_symbols + n - 1) / n;
+    const int depth = traceback_depth_;
+    decoded->resize(num_codewords);
+    for (auto& d : *decoded) {
+        d.resize(num_steps);
+    }
+
+    for (int first = 0; first < num_codewords; first += L) {
+        const int num_lanes = std::min(L, num_codewords - first);
+        ResetBatch(depth ? 2 * depth : num_steps);
+        for (int step = 0; step < num_steps; step++) {
+            UpdateBatchPathMetrics(&symbols[first], num_lanes, num_symbols, step);
+            // Same sliding window decisions as in Decode()
+            if (depth && (step < num_full_steps) &&
+                (num_steps_ - num_decided_ == 2 * depth)) {
+                for (int l = 0; l < num_lanes; l++) {
+                    TracebackBatch(
+                        l, depth, depth, (*decoded)[first + l].data() + num_decided_);
+                }
+                num_decided_ += depth;
+            }
+        }
+        for (int l = 0; l < num_lanes; l++) {
+            TracebackBatch(l,
+                           0,
+                           num_steps_ - num_decided_,
+                           (*decoded)[first + l].data() + num_decided_);
+        }
+        num_decided_ = num_steps_;
+    }
+
+    // Remove (constraint_ - 1) flushing bits.
+    for (auto& d : *decoded) {
+        d.resize(std::max(0, num_steps - constraint_ + 1));
+    }
+}
+
+void ViterbiCodec::Decode(const float* symbols,
+                          int num_symbols,
+                          float scale,
+                          std::vector<uint8_t>* decoded)
+{
+    quantized_.resize(num_symbols);
+    Quantize(symbols, num_symbols, scale, quantized_.data());
+    Decode(quantized_.data(), num_symbols, decoded);
+}
+
+std::string ViterbiCodec::Decode(const std::string& bits)
+{
+    quantized_.resize(bits.size());
+    for (int i = 0; i < (int)bits.size(); i++) {
+        quantized_[i] = bits[i] == '1' ? 127 : -127;
+    }
+    std::vector<uint8_t> decoded_bits;
+    Decode(quantized_.data(), quantized_.size(), &decoded_bits);
+
+    std::string decoded;
+    for (auto b : decoded_bits) {
+        decoded += b ? "1" : "0";
+    }
+    return decoded;
+}
+
+float ViterbiCodec::QuantizationScale(const float* symbols, int num_symbols)
+{
+    // Scale so that the mean amplitude of the symbols is mapped to 32,
+    // leaving room for the larger symbols before saturation.
+    float mean_amplitude = 0.0f;
+    for (int i = 0; i < num_symbols; i++) {
+        mean_amplitude += std::fabs(symbols[i]);
+    }
+    if (mean_amplitude == 0.0f) {
+        return 0.0f;
+    }
+    mean_amplitude /= num_symbols;
+    return 32.0f / mean_amplitude;
+}
+
+void ViterbiCodec::Quantize(const float* symbols,
+                            int num_symbols,
+                            float scale,
+                            int8_t* quantized)
+{
+    for (int i = 0; i < num_symbols; i++) {
+        const float s = std::nearbyint(symbols[i] * scale);
+        quantized[i] = static_cast<int8_t>(std::min(127.0f, std::max(-127.0f, s)));
+    }
 }
@@ -2,16 +2,43 @@
 //
 // Author: Min Xu <xukmin@gmail.com>
 // Date: 01/30/2015
+//
+// Modified for gr-satellites by Daniel Estevez <daniel@destevez.net>:
+// soft-decision decoding with vectorized add-compare-select and packed
+// decision bits.
 
 #ifndef VITERBI_H_
 #define VITERBI_H_
 
+#include "viterbi_acs.h"
+
+#include <cstdint>
 #include <ostream>
 #include <string>
 #include <utility>
 #include <vector>
 
 // This class implements both a Viterbi Decoder and a Convolutional Encoder.
+//
+// The decoder works with soft symbols given as int8_t values, where positive
+// values mean a 1 bit, negative values mean a 0 bit and 0 means an erasure.
+// A ViterbiCodec object keeps internal buffers for decoding, so it must not
+// be used to decode from several threads concurrently.
+//
+// If a traceback depth is given, the decoder works with a sliding window:
+// only the decisions of the last 2 * traceback_depth trellis steps are
+// stored, and the bits are decided incrementally by tracing back
+// traceback_depth steps from the best state. Otherwise, the decisions of the
+// whole codeword are stored and traced back from the best final state.
+//
+// Punctured codes are supported by giving a puncturing pattern. The pattern
+// lists, for each of the encoder output symbols in a puncturing period,
+// whether the symbol is transmitted (1) or deleted (0). The symbols are
+// ordered as they are output by the encoder, so the length of the pattern
+// must be a multiple of the number of polynomials. For instance, the CCSDS
+// rate 2/3 code uses the pattern {1, 1, 0, 1}. The decoder inserts
+// erasures in the deleted positions, so they do not contribute to the
+// branch metrics.
 class ViterbiCodec
 {
 public:
@@ -33,50 +60,152 @@ public:
     //    This representation is used by the Spiral Viterbi Decoder Software
     //    Generator. See http://www.spiral.net/software/viterbi.html
     // We use 2.
-    ViterbiCodec(int constraint, const std::vector<int>& polynomials);
+    ViterbiCodec(int constraint,
+                 const std::vector<int>& polynomials,
+                 int traceback_depth = 0,
+                 const std::vector<int>& puncturing = std::vector<int>());
+
+    // Maximum constraint length supported by the codec
+    static constexpr int kMaxConstraint = 16;
+
+    // Returns true if puncturing is a valid puncturing pattern for a code
+    // with num_parity_bits polynomials. An empty pattern means no
+    // puncturing.
+    static bool ValidPuncturing(const std::vector<int>& puncturing, int num_parity_bits);
+
+    // Throws std::runtime_error if the parameters are not supported. The
+    // constructor only asserts them, so this should be called before
+    // constructing a codec with parameters given by the user.
+    static void CheckParameters(int constraint,
+                                const std::vector<int>& polynomials,
+                                int traceback_depth = 0,
+                                const std::vector<int>& puncturing = std::vector<int>());
 
     std::string Encode(const std::string& bits) const;
 
-    std::string Decode(const std::string& bits) const;
+    // Table-driven encoding of num_bits bits given packed, MSB first,
+    // followed by the (constraint - 1) flushing bits. The encoded symbols,
+    // after puncturing, are written to encoded packed MSB first, and the
+    // number of symbols is returned. When the code has at most 8
+    // polynomials and there is no puncturing, whole input bytes are encoded
+    // at once.
+    int
+    EncodePacked(const uint8_t* data, int num_bits, std::vector<uint8_t>* encoded) const;
 
-    int constraint() const { return constraint_; }
+    // Hard-decision decoding of a string of '0' and '1' characters.
+    std::string Decode(const std::string& bits);
 
-    const std::vector<int>& polynomials() const { return polynomials_; }
+    // Soft-decision decoding. The decoded bits (excluding the flushing bits)
+    // are written unpacked, one bit per byte, to decoded.
+    void Decode(const int8_t* symbols, int num_symbols, std::vector<uint8_t>* decoded);
 
-private:
-    // Suppose
-    //
-    //     Trellis trellis;
+    // Soft-decision decoding of float symbols. The symbols are multiplied by
+    // scale and saturated to the int8_t range before decoding.
+    void Decode(const float* symbols,
+                int num_symbols,
+                float scale,
+                std::vector<uint8_t>* decoded);
+
+    // Streaming decoding. It can only be used if the traceback depth is
+    // non-zero. The puncturing pattern is not applied, so the symbols are
+    // those of the unpunctured code.
     //
-    // Then trellis[i][s] is the state in the (i - 1)th iteration which leads to
-    // the current state s in the ith iteration.
-    // It is used for traceback.
-    typedef std::vector<std::vector<int>> Trellis;
+    // ResetStream() starts a new stream in the zero state. DecodeStream()
+    // processes num_steps trellis steps (num_steps * num_parity_bits()
+    // symbols), writes the bits that have been decided to decoded and
+    // returns how many bits were written, which is at most num_steps +
+    // traceback_depth(). FlushStream() decides all the remaining bits by
+    // tracing back from the best state, writes them to decoded and returns
+    // how many bits were written, which is at most 2 * traceback_depth().
+    void ResetStream();
+    int DecodeStream(const int8_t* symbols, int num_steps, uint8_t* decoded);
+    int FlushStream(uint8_t* decoded);
+
+    // Batch decoding of num_codewords codewords having num_symbols symbols
+    // each. The codewords are decoded in groups of viterbi_acs::kBatchLanes,
+    // with one codeword per SIMD lane, which gives the same results as
+    // decoding each of them with Decode(). The decoded bits of codeword k are
+    // written to (*decoded)[k]. Any stream being decoded is reset.
+    void DecodeBatch(const int8_t* const* symbols,
+                     int num_codewords,
+                     int num_symbols,
+                     std::vector<std::vector<uint8_t>>* decoded);
+
+    // Returns a scale for Quantize() that maps the mean amplitude of the
+    // symbols to 32.
+    static float QuantizationScale(const float* symbols, int num_symbols);
+
+    // Multiplies the symbols by scale and saturates to the int8_t range.
+    static void
+    Quantize(const float* symbols, int num_symbols, float scale, int8_t* quantized);
+
+    int constraint() const { return constraint_; }
 
     int num_parity_bits() const;
 
+    int traceback_depth() const { return traceback_depth_; }
+
+    const std::vector<int>& polynomials() const { return polynomials_; }
+
+    const std::vector<int>& puncturing() const { return puncturing_; }
+
+private:
     void InitializeOutputs();
 
+    void InitializeBranchTables();
+
+    void InitializeEncoderTables();
+
     int NextState(int current_state, int input) const;
 
     std::string Output(int current_state, int input) const;
 
-    int BranchMetric(const std::string& bits, int source_state, int target_state) const;
+    // Initializes the path metrics with the zero state and makes room in
+    // decisions_ for capacity trellis steps.
+    void Reset(int capacity);
+
+    // Path metric of the states other than 0 after a reset.
+    int16_t InitialMetric() const;
+
+    // Advances the circular decisions_ buffer after a trellis step.
+    void NextSlot();
 
-    // Given num_parity_bits() received bits, compute and returns path
-    // metric and its corresponding previous state.
-    std::pair<int, int> PathMetric(const std::string& bits,
-                                   const std::vector<int>& prev_path_metrics,
-                                   int state) const;
+    // Runs the add-compare-select for one trellis step, storing the packed
+    // decisions in the next slot of decisions_.
+    void UpdatePathMetrics(const int8_t* symbols);
 
-    // Given num_parity_bits() received bits, update path metrics of all states
-    // in the current iteration, and append new traceback vector to trellis.
-    void UpdatePathMetrics(const std::string& bits,
-                           std::vector<int>* path_metrics,
-                           Trellis* trellis) const;
+    // Runs the add-compare-select over all the trellis steps covered by
+    // num_symbols. Missing symbols in the last step are taken as erasures.
+    void UpdatePathMetrics(const int8_t* symbols, int num_symbols);
+
+    // Traces back from the best state through the last num_skip + num_out
+    // trellis steps, and writes the bits of the oldest num_out steps.
+    void Traceback(int num_skip, int num_out, uint8_t* decoded) const;
+
+    // Inserts erasures in the positions deleted by the puncturing. Deleted
+    // positions after the last symbol are not inserted, since the decoder
+    // takes the missing symbols of the last trellis step as erasures.
+    void Depuncture(const int8_t* symbols,
+                    int num_symbols,
+                    std::vector<int8_t>* depunctured) const;
+
+    // Batch counterparts of Reset(), UpdatePathMetrics() and Traceback(). The
+    // batch decoder uses a separate set of buffers, but shares the circular
+    // buffer position and step counters with the stream decoder.
+    // UpdateBatchPathMetrics() runs the trellis step step of the codewords
+    // in symbols, taking the missing symbols and the unused lanes as
+    // erasures.
+    void ResetBatch(int capacity);
+    void UpdateBatchPathMetrics(const int8_t* const* symbols,
+                                int num_lanes,
+                                int num_symbols,
+                                int step);
+    void TracebackBatch(int lane, int num_skip, int num_out, uint8_t* decoded) const;
 
     const int constraint_;
     const std::vector<int> polynomials_;
+    const int traceback_depth_;
+    const std::vector<int> puncturing_;
 
     // The output table.
     // The index is current input bit combined with previous inputs in the shift
@@ -85,6 +214,50 @@ private:
     // 0b10 (= 2), and the current input is 0b1 (= 1), then the index is 0b110 (=
     // 6).
     std::vector<std::string> outputs_;
+
+    // Encoder tables. register_outputs_ gives the parity bits (the first one
+    // in the MSB) for each shift register contents, with the newest input
+    // bit in the LSB. Since the code is linear, the symbols produced by an
+    // input byte are the XOR of the symbols produced by the previous
+    // (constraint - 1) bits followed by a zero byte, which are given by
+    // state_outputs_, and the symbols produced by the byte starting from the
+    // zero state, which are given by byte_outputs_. These hold the symbols
+    // packed MSB first.
+    std::vector<uint32_t> register_outputs_;
+    std::vector<uint64_t> state_outputs_;
+    std::vector<uint64_t> byte_outputs_;
+
+    // Branch tables and kernel used by the add-compare-select.
+    viterbi_acs::Tables tables_;
+    viterbi_acs::Kernel kernel_;
+    viterbi_acs::BatchKernel batch_kernel_;
+
+    // Maximum absolute value of the int16_t symbols fed to the kernel. It is
+    // chosen so that path metrics never overflow.
+    int symbol_max_;
+
+    // Decoding state and buffers, reused between calls. decisions_ is a
+    // circular buffer holding decisions_capacity_ trellis steps, and
+    // decisions_slot_ is the slot where the next step will be written.
+    std::vector<int16_t> path_metrics_;
+    std::vector<int16_t> new_path_metrics_;
+    std::vector<uint16_t> decisions_;
+    int decisions_capacity_;
+    int decisions_slot_;
+    // Number of trellis steps processed and decided since the last reset
+    long num_steps_;
+    long num_decided_;
+    std::vector<int8_t> quantized_;
+    std::vector<int8_t> depunctured_;
+
+    // Batch decoding buffers, laid out as described in viterbi_acs.h.
+    // batch_decisions_ has tables_.num_states words per trellis step.
+    std::vector<int16_t> batch_path_metrics_;
+    std::vector<int16_t> batch_new_path_metrics_;
+    std::vector<int16_t> batch_symbols_;
+    std::vector<uint16_t> batch_decisions_;
+    std::vector<std::vector<int8_t>> batch_depunctured_;
+    std::vector<const int8_t*> batch_depunctured_pointers_;
 };
 
 std::ostream& operator<<(std::ostream& os, const ViterbiCodec& codec);
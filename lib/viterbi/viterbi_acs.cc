@@ -0,0 +1,701 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "viterbi_acs.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VITERBI_ACS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(VITERBI_ACS_SSE2) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define VITERBI_ACS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define VITERBI_ACS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace viterbi_acs {
+
+namespace {
+
+constexpr int parity(int x)
+{
+    int p = 0;
+    for (; x; x >>= 1) {
+        p ^= x & 1;
+    }
+    return p;
+}
+
+// The kernels are templates on a Code class that gives the code parameters
+// and the branch masks, with the same layout as in Tables. RuntimeCode
+// takes them from the Tables, while FixedCode generates them at compile
+// time for a particular code, so that the compiler can unroll the loops,
+// discard the symmetric or asymmetric branch metric computation and use
+// the masks as constants.
+class RuntimeCode
+{
+public:
+    explicit RuntimeCode(const Tables& tables) : tables_(tables) {}
+    int num_butterflies() const { return tables_.num_butterflies; }
+    int num_parity_bits() const { return tables_.num_parity_bits; }
+    int words_per_step() const { return tables_.words_per_step; }
+    bool symmetric() const { return tables_.symmetric; }
+    const int16_t* masks() const { return tables_.masks.data(); }
+
+private:
+    const Tables& tables_;
+};
+
+template <int K, int N>
+struct FixedTables {
+    static constexpr int kNumButterflies = 1 << (K - 2);
+
+    int16_t masks[4 * N * kNumButterflies];
+    bool symmetric;
+
+    template <typename... P>
+    constexpr FixedTables(P... polynomials) : masks(), symmetric(true)
+    {
+        const int polys[] = { polynomials... };
+        const int h = kNumButterflies;
+        for (int j = 0; j < N; ++j) {
+            if (!(polys[j] & 1) || !(polys[j] & (1 << (K - 1)))) {
+                symmetric = false;
+            }
+        }
+        for (int b = 0; b < 4; ++b) {
+            for (int i = 0; i < h; ++i) {
+                const int reg = ((i + (b >> 1) * h) << 1) | (b & 1);
+                for (int j = 0; j < N; ++j) {
+                    masks[(b * N + j) * h + i] = parity(reg & polys[j]) ? -1 : 0;
+                }
+            }
+        }
+    }
+};
+
+template <int K, int... Polys>
+class FixedCode
+{
+public:
+    static constexpr int kNumButterflies = 1 << (K - 2);
+    static constexpr int kNumParityBits = sizeof...(Polys);
+    static constexpr FixedTables<K, sizeof...(Polys)> kTables{ Polys... };
+
+    constexpr int num_butterflies() const { return kNumButterflies; }
+    constexpr int num_parity_bits() const { return kNumParityBits; }
+    constexpr int words_per_step() const
+    {
+        return kNumButterflies < 8 ? 1 : kNumButterflies / 8;
+    }
+    constexpr bool symmetric() const { return kTables.symmetric; }
+    const int16_t* masks() const { return kTables.masks; }
+
+    static bool matches(int constraint, const std::vector<int>& polynomials)
+    {
+        return (constraint == K) && (polynomials == std::vector<int>{ Polys... });
+    }
+};
+
+template <int K, int... Polys>
+constexpr FixedTables<K, sizeof...(Polys)> FixedCode<K, Polys...>::kTables;
+
+template <typename Code>
+inline void acs_generic_code(const Code& code,
+                             const int16_t* symbols,
+                             const int16_t* old_metrics,
+                             int16_t* new_metrics,
+                             uint16_t* decisions)
+{
+    const int h = code.num_butterflies();
+    const int n = code.num_parity_bits();
+    const int num_branches = code.symmetric() ? 1 : 4;
+    const int16_t* masks = code.masks();
+    const int norm = old_metrics[0];
+
+    std::fill_n(decisions, code.words_per_step(), 0);
+    for (int i = 0; i < h; ++i) {
+        int bm[4];
+        for (int b = 0; b < num_branches; ++b) {
+            bm[b] = 0;
+            for (int j = 0; j < n; ++j) {
+                const int16_t m = masks[(b * n + j) * h + i];
+                bm[b] += m ? -symbols[j] : symbols[j];
+            }
+        }
+        if (code.symmetric()) {
+            bm[1] = -bm[0];
+            bm[2] = -bm[0];
+            bm[3] = bm[0];
+        }
+        const int a = old_metrics[i] - norm;
+        const int c = old_metrics[i + h] - norm;
+        const int m00 = a + bm[0];
+        const int m01 = a + bm[1];
+        const int m10 = c + bm[2];
+        const int m11 = c + bm[3];
+        const int d0 = m00 > m10;
+        const int d1 = m01 > m11;
+        new_metrics[2 * i] = d0 ? m10 : m00;
+        new_metrics[2 * i + 1] = d1 ? m11 : m01;
+        decisions[i >> 3] |= (d0 << (i & 7)) | (d1 << (8 + (i & 7)));
+    }
+}
+
+#ifdef VITERBI_ACS_SSE2
+template <typename Code>
+inline void acs_sse2_code(const Code& code,
+                          const int16_t* symbols,
+                          const int16_t* old_metrics,
+                          int16_t* new_metrics,
+                          uint16_t* decisions)
+{
+    const int h = code.num_butterflies();
+    const int n = code.num_parity_bits();
+    const int num_branches = code.symmetric() ? 1 : 4;
+    const int16_t* masks = code.masks();
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i norm = _mm_set1_epi16(old_metrics[0]);
+
+    __m128i sym[kMaxParityBits];
+    for (int j = 0; j < n; ++j) {
+        sym[j] = _mm_set1_epi16(symbols[j]);
+    }
+
+    for (int i = 0; i < h; i += 8) {
+        __m128i bm[4];
+        for (int b = 0; b < num_branches; ++b) {
+            __m128i acc = zero;
+            for (int j = 0; j < n; ++j) {
+                const __m128i m = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(&masks[(b * n + j) * h + i]));
+                acc = _mm_add_epi16(acc, _mm_sub_epi16(_mm_xor_si128(sym[j], m), m));
+            }
+            bm[b] = acc;
+        }
+        if (code.symmetric()) {
+            bm[1] = _mm_sub_epi16(zero, bm[0]);
+            bm[2] = bm[1];
+            bm[3] = bm[0];
+        }
+        const __m128i a = _mm_sub_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&old_metrics[i])), norm);
+        const __m128i c = _mm_sub_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&old_metrics[i + h])),
+            norm);
+        const __m128i m00 = _mm_add_epi16(a, bm[0]);
+        const __m128i m01 = _mm_add_epi16(a, bm[1]);
+        const __m128i m10 = _mm_add_epi16(c, bm[2]);
+        const __m128i m11 = _mm_add_epi16(c, bm[3]);
+        const __m128i d0 = _mm_cmpgt_epi16(m00, m10);
+        const __m128i d1 = _mm_cmpgt_epi16(m01, m11);
+        const __m128i n0 = _mm_min_epi16(m00, m10);
+        const __m128i n1 = _mm_min_epi16(m01, m11);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&new_metrics[2 * i]),
+                         _mm_unpacklo_epi16(n0, n1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&new_metrics[2 * i + 8]),
+                         _mm_unpackhi_epi16(n0, n1));
+        decisions[i >> 3] =
+            static_cast<uint16_t>(_mm_movemask_epi8(_mm_packs_epi16(d0, d1)));
+    }
+}
+#endif
+
+#ifdef VITERBI_ACS_AVX2
+template <typename Code>
+__attribute__((target("avx2"))) inline void acs_avx2_code(const Code& code,
+                                                          const int16_t* symbols,
+                                                          const int16_t* old_metrics,
+                                                          int16_t* new_metrics,
+                                                          uint16_t* decisions)
+{
+    const int h = code.num_butterflies();
+    const int n = code.num_parity_bits();
+    const int num_branches = code.symmetric() ? 1 : 4;
+    const int16_t* masks = code.masks();
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i norm = _mm256_set1_epi16(old_metrics[0]);
+
+    __m256i sym[kMaxParityBits];
+    for (int j = 0; j < n; ++j) {
+        sym[j] = _mm256_set1_epi16(symbols[j]);
+    }
+
+    for (int i = 0; i < h; i += 16) {
+        __m256i bm[4];
+        for (int b = 0; b < num_branches; ++b) {
+            __m256i acc = zero;
+            for (int j = 0; j < n; ++j) {
+                const __m256i m = _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(&masks[(b * n + j) * h + i]));
+                acc = _mm256_add_epi16(acc,
+                                       _mm256_sub_epi16(_mm256_xor_si256(sym[j], m), m));
+            }
+            bm[b] = acc;
+        }
+        if (code.symmetric()) {
+            bm[1] = _mm256_sub_epi16(zero, bm[0]);
+            bm[2] = bm[1];
+            bm[3] = bm[0];
+        }
+        const __m256i a = _mm256_sub_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&old_metrics[i])),
+            norm);
+        const __m256i c = _mm256_sub_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&old_metrics[i + h])),
+            norm);
+        const __m256i m00 = _mm256_add_epi16(a, bm[0]);
+        const __m256i m01 = _mm256_add_epi16(a, bm[1]);
+        const __m256i m10 = _mm256_add_epi16(c, bm[2]);
+        const __m256i m11 = _mm256_add_epi16(c, bm[3]);
+        const __m256i d0 = _mm256_cmpgt_epi16(m00, m10);
+        const __m256i d1 = _mm256_cmpgt_epi16(m01, m11);
+        const __m256i n0 = _mm256_min_epi16(m00, m10);
+        const __m256i n1 = _mm256_min_epi16(m01, m11);
+        // unpack works within each 128-bit lane, so the lanes need to be
+        // reordered to get the targets in order
+        const __m256i lo = _mm256_unpacklo_epi16(n0, n1);
+        const __m256i hi = _mm256_unpackhi_epi16(n0, n1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&new_metrics[2 * i]),
+                            _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&new_metrics[2 * i + 16]),
+                            _mm256_permute2x128_si256(lo, hi, 0x31));
+        // packs also works within each lane, which gives the same decision
+        // layout as two consecutive SSE2 iterations
+        const uint32_t d =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(d0, d1)));
+        decisions[i >> 3] = static_cast<uint16_t>(d);
+        decisions[(i >> 3) + 1] = static_cast<uint16_t>(d >> 16);
+    }
+}
+#endif
+
+template <typename Code>
+void acs_fixed_generic(const Tables&,
+                       const int16_t* symbols,
+                       const int16_t* old_metrics,
+                       int16_t* new_metrics,
+                       uint16_t* decisions)
+{
+    acs_generic_code(Code(), symbols, old_metrics, new_metrics, decisions);
+}
+
+#ifdef VITERBI_ACS_SSE2
+void acs_sse2(const Tables& tables,
+              const int16_t* symbols,
+              const int16_t* old_metrics,
+              int16_t* new_metrics,
+              uint16_t* decisions)
+{
+    acs_sse2_code(RuntimeCode(tables), symbols, old_metrics, new_metrics, decisions);
+}
+
+template <typename Code>
+void acs_fixed_sse2(const Tables&,
+                    const int16_t* symbols,
+                    const int16_t* old_metrics,
+                    int16_t* new_metrics,
+                    uint16_t* decisions)
+{
+    acs_sse2_code(Code(), symbols, old_metrics, new_metrics, decisions);
+}
+#endif
+
+#ifdef VITERBI_ACS_AVX2
+__attribute__((target("avx2"))) void acs_avx2(const Tables& tables,
+                                              const int16_t* symbols,
+                                              const int16_t* old_metrics,
+                                              int16_t* new_metrics,
+                                              uint16_t* decisions)
+{
+    acs_avx2_code(RuntimeCode(tables), symbols, old_metrics, new_metrics, decisions);
+}
+
+template <typename Code>
+__attribute__((target("avx2"))) void acs_fixed_avx2(const Tables&,
+                                                    const int16_t* symbols,
+                                                    const int16_t* old_metrics,
+                                                    int16_t* new_metrics,
+                                                    uint16_t* decisions)
+{
+    acs_avx2_code(Code(), symbols, old_metrics, new_metrics, decisions);
+}
+#endif
+
+// Each SIMD kernel is only instantiated for the codes that have enough
+// butterflies to fill its vectors
+template <typename Code, bool kFillsSse2 = (Code::kNumButterflies >= 8)>
+struct FixedKernels {
+    static Kernel select() { return acs_fixed_generic<Code>; }
+};
+
+template <typename Code>
+struct FixedKernels<Code, true> {
+    static Kernel select()
+    {
+#ifdef VITERBI_ACS_AVX2
+        if ((Code::kNumButterflies >= 16) && __builtin_cpu_supports("avx2")) {
+            return acs_fixed_avx2<Code>;
+        }
+#endif
+#ifdef VITERBI_ACS_SSE2
+        return acs_fixed_sse2<Code>;
+#else
+        return acs_fixed_generic<Code>;
+#endif
+    }
+};
+
+} // namespace
+
+void acs_generic(const Tables& tables,
+                 const int16_t* symbols,
+                 const int16_t* old_metrics,
+                 int16_t* new_metrics,
+                 uint16_t* decisions)
+{
+    acs_generic_code(RuntimeCode(tables), symbols, old_metrics, new_metrics, decisions);
+}
+
+Kernel select_kernel(const Tables& tables)
+{
+#ifdef VITERBI_ACS_AVX2
+    if ((tables.num_butterflies >= 16) && __builtin_cpu_supports("avx2")) {
+        return acs_avx2;
+    }
+#endif
+#ifdef VITERBI_ACS_SSE2
+    if (tables.num_butterflies >= 8) {
+        return acs_sse2;
+    }
+#endif
+    return acs_generic;
+}
+
+Kernel select_fixed_kernel(int constraint, const std::vector<int>& polynomials)
+{
+    // Codes used by the gr-satellites decoders
+    typedef FixedCode<7, 79, 109> CodeK7;
+    typedef FixedCode<7, 109, 79> CodeK7Swapped;
+    typedef FixedCode<5, 25, 23> CodeK5;
+    typedef FixedCode<3, 7, 5> CodeK3;
+
+    if (CodeK7::matches(constraint, polynomials)) {
+        return FixedKernels<CodeK7>::select();
+    }
+    if (CodeK7Swapped::matches(constraint, polynomials)) {
+        return FixedKernels<CodeK7Swapped>::select();
+    }
+    if (CodeK5::matches(constraint, polynomials)) {
+        return FixedKernels<CodeK5>::select();
+    }
+    if (CodeK3::matches(constraint, polynomials)) {
+        return FixedKernels<CodeK3>::select();
+    }
+    return nullptr;
+}
+
+void acs_batch_generic(const Tables& tables,
+                       const int16_t* symbols,
+                       const int16_t* old_metrics,
+                       int16_t* new_metrics,
+                       uint16_t* decisions)
+{
+    const int h = tables.num_butterflies;
+    const int n = tables.num_parity_bits;
+    const int num_branches = tables.symmetric ? 1 : 4;
+    constexpr int L = kBatchLanes;
+
+    // The loops over the lanes are written so that the compiler can
+    // vectorize them.
+    for (int i = 0; i < h; ++i) {
+        int16_t bm[4][L];
+        for (int b = 0; b < num_branches; ++b) {
+            std::fill_n(bm[b], L, 0);
+            for (int j = 0; j < n; ++j) {
+                const int16_t m = tables.masks[(b * n + j) * h + i];
+                for (int l = 0; l < L; ++l) {
+                    bm[b][l] += (symbols[j * L + l] ^ m) - m;
+                }
+            }
+        }
+        if (tables.symmetric) {
+            for (int l = 0; l < L; ++l) {
+                bm[1][l] = -bm[0][l];
+                bm[2][l] = bm[1][l];
+                bm[3][l] = bm[0][l];
+            }
+        }
+        const int16_t* a = &old_metrics[i * L];
+        const int16_t* c = &old_metrics[(i + h) * L];
+        int16_t* n0 = &new_metrics[2 * i * L];
+        int16_t* n1 = &new_metrics[(2 * i + 1) * L];
+        uint16_t d0 = 0;
+        uint16_t d1 = 0;
+        for (int l = 0; l < L; ++l) {
+            const int16_t m00 = a[l] - old_metrics[l] + bm[0][l];
+            const int16_t m01 = a[l] - old_metrics[l] + bm[1][l];
+            const int16_t m10 = c[l] - old_metrics[l] + bm[2][l];
+            const int16_t m11 = c[l] - old_metrics[l] + bm[3][l];
+            d0 |= (m00 > m10) << l;
+            d1 |= (m01 > m11) << l;
+            n0[l] = std::min(m00, m10);
+            n1[l] = std::min(m01, m11);
+        }
+        decisions[2 * i] = d0;
+        decisions[2 * i + 1] = d1;
+    }
+}
+
+// The SIMD batch kernels compute at the start of each trellis step the
+// branch metrics for all the possible codes, since there are at most
+// 2^kMaxBatchParityBits of them.
+
+#ifdef VITERBI_ACS_SSE2
+// Each group of kBatchLanes lanes is processed as two halves of 8 lanes
+static void acs_batch_sse2(const Tables& tables,
+                           const int16_t* symbols,
+                           const int16_t* old_metrics,
+                           int16_t* new_metrics,
+                           uint16_t* decisions)
+{
+    const int h = tables.num_butterflies;
+    const int n = tables.num_parity_bits;
+    const uint32_t* codes = tables.codes.data();
+    const uint32_t* codes_high = tables.symmetric ? codes : &codes[2 * h];
+    const int num_codes = 1 << n;
+    constexpr int L = kBatchLanes;
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i bm[2][1 << kMaxBatchParityBits];
+    __m128i norm[2];
+    for (int half = 0; half < 2; ++half) {
+        for (int c = 0; c < num_codes; ++c) {
+            __m128i acc = zero;
+            for (int j = 0; j < n; ++j) {
+                const __m128i s = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(&symbols[j * L + 8 * half]));
+                acc = (c >> j) & 1 ? _mm_sub_epi16(acc, s) : _mm_add_epi16(acc, s);
+            }
+            bm[half][c] = acc;
+        }
+        norm[half] =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&old_metrics[8 * half]));
+    }
+
+    for (int i = 0; i < h; ++i) {
+        __m128i d0[2], d1[2];
+        for (int half = 0; half < 2; ++half) {
+            const int lane = 8 * half;
+            __m128i bm00, bm01, bm10, bm11;
+            if (tables.symmetric) {
+                bm00 = bm[half][codes[i]];
+                bm01 = _mm_sub_epi16(zero, bm00);
+                bm10 = bm01;
+                bm11 = bm00;
+            } else {
+                bm00 = bm[half][codes[i]];
+                bm01 = bm[half][codes[h + i]];
+                bm10 = bm[half][codes_high[i]];
+                bm11 = bm[half][codes_high[h + i]];
+            }
+            const __m128i a = _mm_sub_epi16(
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(&old_metrics[i * L + lane])),
+                norm[half]);
+            const __m128i c = _mm_sub_epi16(
+                _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(&old_metrics[(i + h) * L + lane])),
+                norm[half]);
+            const __m128i m00 = _mm_add_epi16(a, bm00);
+            const __m128i m01 = _mm_add_epi16(a, bm01);
+            const __m128i m10 = _mm_add_epi16(c, bm10);
+            const __m128i m11 = _mm_add_epi16(c, bm11);
+            d0[half] = _mm_cmpgt_epi16(m00, m10);
+            d1[half] = _mm_cmpgt_epi16(m01, m11);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&new_metrics[2 * i * L + lane]),
+                             _mm_min_epi16(m00, m10));
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(&new_metrics[(2 * i + 1) * L + lane]),
+                _mm_min_epi16(m01, m11));
+        }
+        decisions[2 * i] =
+            static_cast<uint16_t>(_mm_movemask_epi8(_mm_packs_epi16(d0[0], d0[1])));
+        decisions[2 * i + 1] =
+            static_cast<uint16_t>(_mm_movemask_epi8(_mm_packs_epi16(d1[0], d1[1])));
+    }
+}
+#endif
+
+#ifdef VITERBI_ACS_AVX2
+__attribute__((target("avx2"))) static void
+acs_batch_avx2(const Tables& tables,
+               const int16_t* symbols,
+               const int16_t* old_metrics,
+               int16_t* new_metrics,
+               uint16_t* decisions)
+{
+    const int h = tables.num_butterflies;
+    const int n = tables.num_parity_bits;
+    const uint32_t* codes = tables.codes.data();
+    const uint32_t* codes_high = tables.symmetric ? codes : &codes[2 * h];
+    const int num_codes = 1 << n;
+    static_assert(kBatchLanes == 16, "the AVX2 batch kernel uses 16 lanes");
+    constexpr int L = kBatchLanes;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i norm =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&old_metrics[0]));
+
+    __m256i bm[1 << kMaxBatchParityBits];
+    for (int c = 0; c < num_codes; ++c) {
+        __m256i acc = zero;
+        for (int j = 0; j < n; ++j) {
+            const __m256i s =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&symbols[j * L]));
+            acc = (c >> j) & 1 ? _mm256_sub_epi16(acc, s) : _mm256_add_epi16(acc, s);
+        }
+        bm[c] = acc;
+    }
+
+    for (int i = 0; i < h; ++i) {
+        __m256i bm00, bm01, bm10, bm11;
+        if (tables.symmetric) {
+            bm00 = bm[codes[i]];
+            bm01 = _mm256_sub_epi16(zero, bm00);
+            bm10 = bm01;
+            bm11 = bm00;
+        } else {
+            bm00 = bm[codes[i]];
+            bm01 = bm[codes[h + i]];
+            bm10 = bm[codes_high[i]];
+            bm11 = bm[codes_high[h + i]];
+        }
+        const __m256i a = _mm256_sub_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&old_metrics[i * L])),
+            norm);
+        const __m256i c = _mm256_sub_epi16(
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(&old_metrics[(i + h) * L])),
+            norm);
+        const __m256i m00 = _mm256_add_epi16(a, bm00);
+        const __m256i m01 = _mm256_add_epi16(a, bm01);
+        const __m256i m10 = _mm256_add_epi16(c, bm10);
+        const __m256i m11 = _mm256_add_epi16(c, bm11);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&new_metrics[2 * i * L]),
+                            _mm256_min_epi16(m00, m10));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&new_metrics[(2 * i + 1) * L]),
+                            _mm256_min_epi16(m01, m11));
+        // packs works within each 128-bit lane, so the 64-bit quarters are
+        // reordered to get all the lanes of each target state together
+        const __m256i d0 = _mm256_cmpgt_epi16(m00, m10);
+        const __m256i d1 = _mm256_cmpgt_epi16(m01, m11);
+        const __m256i d = _mm256_permute4x64_epi64(_mm256_packs_epi16(d0, d1), 0xd8);
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(d));
+        decisions[2 * i] = static_cast<uint16_t>(mask);
+        decisions[2 * i + 1] = static_cast<uint16_t>(mask >> 16);
+    }
+}
+#endif
+
+#ifdef VITERBI_ACS_NEON
+// Each group of kBatchLanes lanes is processed as two halves of 8 lanes
+static void acs_batch_neon(const Tables& tables,
+                           const int16_t* symbols,
+                           const int16_t* old_metrics,
+                           int16_t* new_metrics,
+                           uint16_t* decisions)
+{
+    const int h = tables.num_butterflies;
+    const int n = tables.num_parity_bits;
+    const uint32_t* codes = tables.codes.data();
+    const uint32_t* codes_high = tables.symmetric ? codes : &codes[2 * h];
+    const int num_codes = 1 << n;
+    constexpr int L = kBatchLanes;
+    static const uint16_t bit_weights[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint16x8_t weights = vld1q_u16(bit_weights);
+
+    int16x8_t bm[2][1 << kMaxBatchParityBits];
+    int16x8_t norm[2];
+    for (int half = 0; half < 2; ++half) {
+        for (int c = 0; c < num_codes; ++c) {
+            int16x8_t acc = vdupq_n_s16(0);
+            for (int j = 0; j < n; ++j) {
+                const int16x8_t s = vld1q_s16(&symbols[j * L + 8 * half]);
+                acc = (c >> j) & 1 ? vsubq_s16(acc, s) : vaddq_s16(acc, s);
+            }
+            bm[half][c] = acc;
+        }
+        norm[half] = vld1q_s16(&old_metrics[8 * half]);
+    }
+
+    for (int i = 0; i < h; ++i) {
+        uint16_t d0 = 0;
+        uint16_t d1 = 0;
+        for (int half = 0; half < 2; ++half) {
+            const int lane = 8 * half;
+            int16x8_t bm00, bm01, bm10, bm11;
+            if (tables.symmetric) {
+                bm00 = bm[half][codes[i]];
+                bm01 = vnegq_s16(bm00);
+                bm10 = bm01;
+                bm11 = bm00;
+            } else {
+                bm00 = bm[half][codes[i]];
+                bm01 = bm[half][codes[h + i]];
+                bm10 = bm[half][codes_high[i]];
+                bm11 = bm[half][codes_high[h + i]];
+            }
+            const int16x8_t a =
+                vsubq_s16(vld1q_s16(&old_metrics[i * L + lane]), norm[half]);
+            const int16x8_t c =
+                vsubq_s16(vld1q_s16(&old_metrics[(i + h) * L + lane]), norm[half]);
+            const int16x8_t m00 = vaddq_s16(a, bm00);
+            const int16x8_t m01 = vaddq_s16(a, bm01);
+            const int16x8_t m10 = vaddq_s16(c, bm10);
+            const int16x8_t m11 = vaddq_s16(c, bm11);
+            vst1q_s16(&new_metrics[2 * i * L + lane], vminq_s16(m00, m10));
+            vst1q_s16(&new_metrics[(2 * i + 1) * L + lane], vminq_s16(m01, m11));
+            d0 |= vaddvq_u16(vandq_u16(vcgtq_s16(m00, m10), weights)) << lane;
+            d1 |= vaddvq_u16(vandq_u16(vcgtq_s16(m01, m11), weights)) << lane;
+        }
+        decisions[2 * i] = d0;
+        decisions[2 * i + 1] = d1;
+    }
+}
+#endif
+
+BatchKernel select_batch_kernel(const Tables& tables)
+{
+    if (tables.num_parity_bits > kMaxBatchParityBits) {
+        return acs_batch_generic;
+    }
+#ifdef VITERBI_ACS_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return acs_batch_avx2;
+    }
+#endif
+#if defined(VITERBI_ACS_SSE2)
+    return acs_batch_sse2;
+#elif defined(VITERBI_ACS_NEON)
+    return acs_batch_neon;
+#else
+    return acs_batch_generic;
+#endif
+}
+
+} // namespace viterbi_acs
@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef VITERBI_ACS_H_
+#define VITERBI_ACS_H_
+
+#include <cstdint>
+#include <vector>
+
+// Add-compare-select kernels for the ViterbiCodec.
+//
+// Internally the trellis uses the state convention where the newest input
+// bit is the LSB of the state. Butterfly i joins the source states i and
+// i + H, where H = num_butterflies, with the target states 2 * i and
+// 2 * i + 1. The decisions of each trellis step are stored as packed bits in
+// uint16_t words. Word i / 8 holds the decision of target 2 * i in bit i % 8
+// and the decision of target 2 * i + 1 in bit 8 + i % 8. A decision bit is 1
+// if the survivor comes from source state i + H.
+namespace viterbi_acs {
+
+// Maximum number of parity bits (polynomials) supported by the kernels
+constexpr int kMaxParityBits = 32;
+
+// Number of codewords decoded simultaneously by the batch kernels
+constexpr int kBatchLanes = 16;
+
+// Maximum number of parity bits supported by the SIMD batch kernels
+constexpr int kMaxBatchParityBits = 4;
+
+struct Tables {
+    int num_states;
+    int num_butterflies;
+    int num_parity_bits;
+    int words_per_step;
+    // If true, only the masks for branch 0 are present, since the other
+    // branch metrics are equal to it or to its negative.
+    bool symmetric;
+    // Branch sign masks. For branch b (0: source i, input 0; 1: source i,
+    // input 1; 2: source i + H, input 0; 3: source i + H, input 1), parity
+    // bit j and butterfly i, the element (b * num_parity_bits + j) *
+    // num_butterflies + i is -1 if the encoder outputs a 1 and 0 otherwise.
+    std::vector<int16_t> masks;
+    // Branch codes, used by the batch kernels. The element b *
+    // num_butterflies + i has bit j set if the encoder outputs a 1 in parity
+    // bit j for branch b and butterfly i.
+    std::vector<uint32_t> codes;
+};
+
+// Performs one trellis step. The branch metric is the sum of the symbols,
+// negated for the parity bits that are 1, so smaller path metrics are
+// better. The path metrics are normalized by subtracting old_metrics[0].
+typedef void (*Kernel)(const Tables& tables,
+                       const int16_t* symbols,
+                       const int16_t* old_metrics,
+                       int16_t* new_metrics,
+                       uint16_t* decisions);
+
+void acs_generic(const Tables& tables,
+                 const int16_t* symbols,
+                 const int16_t* old_metrics,
+                 int16_t* new_metrics,
+                 uint16_t* decisions);
+
+// Returns the fastest kernel supported by the CPU for these tables
+Kernel select_kernel(const Tables& tables);
+
+// Returns the fastest kernel supported by the CPU among those specialized
+// at compile time for the code with these constraint length and
+// polynomials, or nullptr if the code has no specialized kernels. The
+// specialized kernels give the same results as those returned by
+// select_kernel().
+Kernel select_fixed_kernel(int constraint, const std::vector<int>& polynomials);
+
+// Performs one trellis step for kBatchLanes independent codewords, with one
+// codeword per SIMD lane. The symbols are stored as num_parity_bits groups
+// of kBatchLanes elements, and the path metrics as num_states groups of
+// kBatchLanes elements. There is a decision word per target state, whose
+// bit l holds the decision for lane l. Each lane gives the same results as
+// the single codeword kernels.
+typedef void (*BatchKernel)(const Tables& tables,
+                            const int16_t* symbols,
+                            const int16_t* old_metrics,
+                            int16_t* new_metrics,
+                            uint16_t* decisions);
+
+void acs_batch_generic(const Tables& tables,
+                       const int16_t* symbols,
+                       const int16_t* old_metrics,
+                       int16_t* new_metrics,
+                       uint16_t* decisions);
+
+// Returns the fastest batch kernel supported by the CPU for these tables
+BatchKernel select_batch_kernel(const Tables& tables);
+
+} // namespace viterbi_acs
+
+#endif // VITERBI_ACS_H_
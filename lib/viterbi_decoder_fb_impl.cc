@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "viterbi_decoder_fb_impl.h"
+#include <gnuradio/io_signature.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+namespace satellites {
+
+constexpr float viterbi_decoder_fb_impl::d_amplitude_alpha;
+
+viterbi_decoder_fb::sptr viterbi_decoder_fb::make(int constraint,
+                                                  const std::vector<int>& polynomials,
+                                                  int traceback_depth)
+{
+    return gnuradio::make_block_sptr<viterbi_decoder_fb_impl>(
+        constraint, polynomials, traceback_depth);
+}
+
+/*
+ * The private constructor
+ */
+viterbi_decoder_fb_impl::viterbi_decoder_fb_impl(int constraint,
+                                                 const std::vector<int>& polynomials,
+                                                 int traceback_depth)
+    : gr::sync_decimator("viterbi_decoder_fb",
+                         gr::io_signature::make(1, 1, sizeof(float)),
+                         gr::io_signature::make(1, 1, sizeof(uint8_t)),
+                         polynomials.size()),
+      d_codec(make_codec(constraint, polynomials, traceback_depth)),
+      d_amplitude(0.0f)
+{
+    d_codec.ResetStream();
+    // The codec decides bits in bursts of traceback_depth bits once it has
+    // 2 * traceback_depth undecided bits. Starting with 2 * traceback_depth - 1
+    // zeros guarantees that there are always enough bits to output.
+    d_pending.assign(2 * traceback_depth - 1, 0);
+}
+
+ViterbiCodec viterbi_decoder_fb_impl::make_codec(int constraint,
+                                                 const std::vector<int>& polynomials,
+                                                 int traceback_depth)
+{
+    if (traceback_depth <= 0) {
+        throw std::runtime_error("traceback_depth must be positive");
+    }
+    ViterbiCodec::CheckParameters(constraint, polynomials, traceback_depth);
+    return ViterbiCodec(constraint, polynomials, traceback_depth);
+}
+
+/*
+ * Our virtual destructor.
+ */
+viterbi_decoder_fb_impl::~viterbi_decoder_fb_impl() {}
+
+int viterbi_decoder_fb_impl::work(int noutput_items,
+                                  gr_vector_const_void_star& input_items,
+                                  gr_vector_void_star& output_items)
+{
+    auto in = static_cast<const float*>(input_items[0]);
+    auto out = static_cast<uint8_t*>(output_items[0]);
+
+    const int num_symbols = noutput_items * d_codec.num_parity_bits();
+
+    // The path metrics accumulate across calls, so the symbols are not
+    // quantized with the mean amplitude of each buffer as in the PDU
+    // decoder, but with a running average that maps to 32 in the same way.
+    if (d_amplitude == 0.0f) {
+        const float scale = ViterbiCodec::QuantizationScale(in, num_symbols);
+        d_amplitude = scale == 0.0f ? 0.0f : 32.0f / scale;
+    } else {
+        for (int j = 0; j < num_symbols; ++j) {
+            d_amplitude += d_amplitude_alpha * (std::fabs(in[j]) - d_amplitude);
+        }
+    }
+    d_symbols.resize(num_symbols);
+    ViterbiCodec::Quantize(in,
+                           num_symbols,
+                           d_amplitude == 0.0f ? 0.0f : 32.0f / d_amplitude,
+                           d_symbols.data());
+
+    const size_t pending = d_pending.size();
+    d_pending.resize(pending + noutput_items + d_codec.traceback_depth());
+    const int decided =
+        d_codec.DecodeStream(d_symbols.data(), noutput_items, &d_pending[pending]);
+    d_pending.resize(pending + decided);
+
+    std::copy_n(d_pending.begin(), noutput_items, out);
+    d_pending.erase(d_pending.begin(), d_pending.begin() + noutput_items);
+
+    return noutput_items;
+}
+
+} /* namespace satellites */
+} /* namespace gr */
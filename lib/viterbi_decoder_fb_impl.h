@@ -0,0 +1,54 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Daniel Estevez <daniel@destevez.net>
+ *
+ * This file is part of gr-satellites
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#ifndef INCLUDED_SATELLITES_VITERBI_DECODER_FB_IMPL_H
+#define INCLUDED_SATELLITES_VITERBI_DECODER_FB_IMPL_H
+
+#include "viterbi/viterbi.h"
+
+#include <satellites/viterbi_decoder_fb.h>
+
+#include <vector>
+
+namespace gr {
+namespace satellites {
+
+class viterbi_decoder_fb_impl : public viterbi_decoder_fb
+{
+private:
+    ViterbiCodec d_codec;
+    std::vector<int8_t> d_symbols;
+    // Bits decided by the codec which have not been output yet
+    std::vector<uint8_t> d_pending;
+    // Running average of the symbol amplitude, used to quantize all the
+    // stream with a slowly varying scale. It is zero until the first
+    // non-zero symbols are seen.
+    float d_amplitude;
+    constexpr static float d_amplitude_alpha = 1.0f / 1024.0f;
+
+    static ViterbiCodec make_codec(int constraint,
+                                   const std::vector<int>& polynomials,
+                                   int traceback_depth);
+
+public:
+    viterbi_decoder_fb_impl(int constraint,
+                            const std::vector<int>& polynomials,
+                            int traceback_depth);
+    ~viterbi_decoder_fb_impl();
+
+    int work(int noutput_items,
+             gr_vector_const_void_star& input_items,
+             gr_vector_void_star& output_items);
+};
+
+} // namespace satellites
+} // namespace gr
+
+#endif /* INCLUDED_SATELLITES_VITERBI_DECODER_FB_IMPL_H */
@@ -15,31 +15,53 @@
 #include "viterbi_decoder_impl.h"
 #include <gnuradio/io_signature.h>
 
-#include <string>
+#include <stdexcept>
 #include <vector>
 
 namespace gr {
 namespace satellites {
 
 viterbi_decoder::sptr viterbi_decoder::make(int constraint,
-                                            const std::vector<int>& polynomials)
+                                            const std::vector<int>& polynomials,
+                                            int traceback_depth,
+                                            int batch_size,
+                                            const std::vector<int>& puncturing)
 {
-    return gnuradio::make_block_sptr<viterbi_decoder_impl>(constraint, polynomials);
+    return gnuradio::make_block_sptr<viterbi_decoder_impl>(
+        constraint, polynomials, traceback_depth, batch_size, puncturing);
 }
 
 /*
  * The private constructor
  */
 viterbi_decoder_impl::viterbi_decoder_impl(int constraint,
-                                           const std::vector<int>& polynomials)
+                                           const std::vector<int>& polynomials,
+                                           int traceback_depth,
+                                           int batch_size,
+                                           const std::vector<int>& puncturing)
     : gr::block("viterbi_decoder",
                 gr::io_signature::make(0, 0, 0),
                 gr::io_signature::make(0, 0, 0)),
-      d_codec(constraint, polynomials)
+      d_codec(make_codec(constraint, polynomials, traceback_depth, puncturing)),
+      d_batch_size(batch_size),
+      d_in_port(pmt::mp("in"))
 {
+    if (batch_size < 1) {
+        throw std::runtime_error("batch_size must be positive");
+    }
+
     message_port_register_out(pmt::mp("out"));
-    message_port_register_in(pmt::mp("in"));
-    set_msg_handler(pmt::mp("in"), [this](pmt::pmt_t msg) { this->msg_handler(msg); });
+    message_port_register_in(d_in_port);
+    set_msg_handler(d_in_port, [this](pmt::pmt_t msg) { this->msg_handler(msg); });
+}
+
+ViterbiCodec viterbi_decoder_impl::make_codec(int constraint,
+                                              const std::vector<int>& polynomials,
+                                              int traceback_depth,
+                                              const std::vector<int>& puncturing)
+{
+    ViterbiCodec::CheckParameters(constraint, polynomials, traceback_depth, puncturing);
+    return ViterbiCodec(constraint, polynomials, traceback_depth, puncturing);
 }
 
 /*
@@ -56,26 +78,100 @@ int viterbi_decoder_impl::general_work(int noutput_items,
 }
 
 
+bool viterbi_decoder_impl::get_symbols(pmt::pmt_t msg, std::vector<int8_t>* symbols)
+{
+    size_t size;
+
+    if (pmt::is_u8vector(msg)) {
+        // Hard decision bits
+        const uint8_t* bits = pmt::u8vector_elements(msg, size);
+        symbols->resize(size);
+        for (size_t j = 0; j < size; ++j) {
+            (*symbols)[j] = bits[j] ? 127 : -127;
+        }
+    } else if (pmt::is_s8vector(msg)) {
+        const int8_t* soft = pmt::s8vector_elements(msg, size);
+        symbols->assign(soft, soft + size);
+    } else if (pmt::is_f32vector(msg)) {
+        const float* soft = pmt::f32vector_elements(msg, size);
+        symbols->resize(size);
+        ViterbiCodec::Quantize(
+            soft, size, ViterbiCodec::QuantizationScale(soft, size), symbols->data());
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
 void viterbi_decoder_impl::msg_handler(pmt::pmt_t pmt_msg)
 {
-    std::vector<uint8_t> msg = pmt::u8vector_elements(pmt::cdr(pmt_msg));
-    std::string bits;
-    for (auto b : msg) {
-        bits.push_back(b ? '1' : '0');
+    if (d_batch_size > 1) {
+        batch_msg_handler(pmt_msg);
+        return;
     }
 
-    std::string outbits = d_codec.Decode(bits);
-    std::vector<uint8_t> out;
-    for (auto b : outbits) {
-        out.push_back(b == '1');
+    if (!get_symbols(pmt::cdr(pmt_msg), &d_symbols)) {
+        d_logger->error("Invalid PDU type; dropping");
+        return;
     }
+    d_codec.Decode(d_symbols.data(), d_symbols.size(), &d_out);
 
     message_port_pub(pmt::mp("out"),
-                     pmt::cons(pmt::car(pmt_msg), pmt::init_u8vector(out.size(), out)));
+                     pmt::cons(pmt::car(pmt_msg), pmt::init_u8vector(d_out.size(), d_out)));
 
     return;
 }
 
+void viterbi_decoder_impl::batch_msg_handler(pmt::pmt_t pmt_msg)
+{
+    // Take the PDUs that are already waiting in the input queue, up to the
+    // batch size
+    d_batch_msgs.assign(1, pmt_msg);
+    while (static_cast<int>(d_batch_msgs.size()) < d_batch_size) {
+        pmt::pmt_t next = delete_head_nowait(d_in_port);
+        if (!next) {
+            break;
+        }
+        d_batch_msgs.push_back(next);
+    }
+
+    d_batch_meta.clear();
+    d_batch_symbols.resize(d_batch_msgs.size());
+    for (const auto& m : d_batch_msgs) {
+        if (!get_symbols(pmt::cdr(m), &d_batch_symbols[d_batch_meta.size()])) {
+            d_logger->error("Invalid PDU type; dropping");
+            continue;
+        }
+        d_batch_meta.push_back(pmt::car(m));
+    }
+
+    // Runs of consecutive PDUs with the same length are decoded together,
+    // so that the output order is preserved
+    size_t first = 0;
+    while (first < d_batch_meta.size()) {
+        const size_t size = d_batch_symbols[first].size();
+        size_t last = first + 1;
+        while ((last < d_batch_meta.size()) && (d_batch_symbols[last].size() == size)) {
+            ++last;
+        }
+
+        d_batch_pointers.clear();
+        for (size_t k = first; k < last; ++k) {
+            d_batch_pointers.push_back(d_batch_symbols[k].data());
+        }
+        d_codec.DecodeBatch(d_batch_pointers.data(), last - first, size, &d_batch_out);
+
+        for (size_t k = first; k < last; ++k) {
+            const auto& out = d_batch_out[k - first];
+            message_port_pub(
+                pmt::mp("out"),
+                pmt::cons(d_batch_meta[k], pmt::init_u8vector(out.size(), out)));
+        }
+        first = last;
+    }
+}
+
 
 } /* namespace satellites */
 } /* namespace gr */
@@ -22,9 +22,34 @@ class viterbi_decoder_impl : public viterbi_decoder
 {
 private:
     ViterbiCodec d_codec;
+    const int d_batch_size;
+    const pmt::pmt_t d_in_port;
+    std::vector<int8_t> d_symbols;
+    std::vector<uint8_t> d_out;
+
+    std::vector<pmt::pmt_t> d_batch_msgs;
+    std::vector<pmt::pmt_t> d_batch_meta;
+    std::vector<std::vector<int8_t>> d_batch_symbols;
+    std::vector<const int8_t*> d_batch_pointers;
+    std::vector<std::vector<uint8_t>> d_batch_out;
+
+    static ViterbiCodec make_codec(int constraint,
+                                   const std::vector<int>& polynomials,
+                                   int traceback_depth,
+                                   const std::vector<int>& puncturing);
+
+    // Converts the PDU contents to int8_t soft symbols. Returns false if
+    // the PDU type is invalid.
+    bool get_symbols(pmt::pmt_t msg, std::vector<int8_t>* symbols);
+
+    void batch_msg_handler(pmt::pmt_t pmt_msg);
 
 public:
-    viterbi_decoder_impl(int constraint, const std::vector<int>& polynomials);
+    viterbi_decoder_impl(int constraint,
+                         const std::vector<int>& polynomials,
+                         int traceback_depth,
+                         int batch_size,
+                         const std::vector<int>& puncturing);
     ~viterbi_decoder_impl();
 
     int general_work(int noutput_items,
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(convolutional_encoder.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(a6495f8aaff7b500ea1b88467f005622)                     */
+/* BINDTOOL_HEADER_FILE_HASH(dd29e8d3280eaf5a8b57f49fd91c46ac)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -42,6 +42,9 @@ void bind_convolutional_encoder(py::module& m)
         .def(py::init(&convolutional_encoder::make),
              py::arg("constraint"),
              py::arg("polynomials"),
+             py::arg("puncturing") = std::vector<int>(),
+             py::arg("packed_input") = false,
+             py::arg("packed_output") = false,
              D(convolutional_encoder, make))
 
 
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(crc_check.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(d91fae7370b0735c7d4bfe9f96d89c12)                     */
+/* BINDTOOL_HEADER_FILE_HASH(bcfcc6ea8e43cde400bee190c25f80ca)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -46,6 +46,8 @@ void bind_crc_check(py::module& m)
              py::arg("swap_endianness"),
              py::arg("discard_crc") = false,
              py::arg("skip_header_bytes") = 0,
+             py::arg("max_bit_errors") = 0,
+             py::arg("max_frame_len") = 256,
              D(crc_check, make))
 
 
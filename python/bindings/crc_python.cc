@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(crc.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(50f159acddf06e987b76f4a7c57e04e9)                     */
+/* BINDTOOL_HEADER_FILE_HASH(7327e17f517404f4485ba0f710761fe1)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -47,18 +47,51 @@ void bind_crc(py::module& m)
 
 
         .def("compute",
-             (uint64_t(crc::*)(uint8_t const*, std::size_t)) & crc::compute,
+             (uint64_t(crc::*)(uint8_t const*, std::size_t) const) & crc::compute,
              py::arg("data"),
              py::arg("len"),
              D(crc, compute, 0))
 
 
         .def("compute",
-             (uint64_t(crc::*)(
-                 std::vector<unsigned char, std::allocator<unsigned char>> const)) &
+             (uint64_t(crc::*)(std::vector<unsigned char, std::allocator<unsigned char>>
+                                   const&) const) &
                  crc::compute,
              py::arg("data"),
              D(crc, compute, 1))
 
+
+        .def("init", &crc::init, D(crc, init))
+
+
+        .def("update",
+             (uint64_t(crc::*)(uint64_t, uint8_t const*, std::size_t) const) &
+                 crc::update,
+             py::arg("state"),
+             py::arg("data"),
+             py::arg("len"),
+             D(crc, update, 0))
+
+
+        .def("update",
+             (uint64_t(crc::*)(uint64_t,
+                               std::vector<unsigned char, std::allocator<unsigned char>>
+                                   const&) const) &
+                 crc::update,
+             py::arg("state"),
+             py::arg("data"),
+             D(crc, update, 1))
+
+
+        .def("finalize", &crc::finalize, py::arg("state"), D(crc, finalize))
+
+
+        .def("combine",
+             &crc::combine,
+             py::arg("crc_a"),
+             py::arg("crc_b"),
+             py::arg("len_b"),
+             D(crc, combine))
+
         ;
 }
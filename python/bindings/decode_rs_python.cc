@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(decode_rs.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(f2a632f6d952d303afb5d6698cc3ac3f)                     */
+/* BINDTOOL_HEADER_FILE_HASH(cfcc8277754186fb7e8b15c010815a0a)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -28,3 +28,18 @@ static const char* __doc_gr_satellites_crc_compute_0 = R"doc()doc";
 
 
 static const char* __doc_gr_satellites_crc_compute_1 = R"doc()doc";
+
+
+static const char* __doc_gr_satellites_crc_init = R"doc()doc";
+
+
+static const char* __doc_gr_satellites_crc_update_0 = R"doc()doc";
+
+
+static const char* __doc_gr_satellites_crc_update_1 = R"doc()doc";
+
+
+static const char* __doc_gr_satellites_crc_finalize = R"doc()doc";
+
+
+static const char* __doc_gr_satellites_crc_combine = R"doc()doc";
@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(doppler_correction.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(56444490a7f522137e132976be778b10)                     */
+/* BINDTOOL_HEADER_FILE_HASH(eb643bf3254c966550228578b289b1c1)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
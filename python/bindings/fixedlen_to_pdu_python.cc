@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(fixedlen_to_pdu.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(ee51137386e71610d87ab3bd1c5ccbf2)                     */
+/* BINDTOOL_HEADER_FILE_HASH(4f58db07f6d735f6f9c6594b341adb90)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -44,6 +44,8 @@ void bind_fixedlen_to_pdu(py::module& m)
              py::arg("syncword_tag"),
              py::arg("packet_len"),
              py::arg("pack") = false,
+             py::arg("quantize") = false,
+             py::arg("scale") = 1.0f,
              D(fixedlen_to_pdu, make))
 
 
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2021 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(max_log_map_decoder.h)                                    */
+/* BINDTOOL_HEADER_FILE_HASH(7960256d092c7e330a51757180da6807)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <satellites/max_log_map_decoder.h>
+// pydoc.h is automatically generated in the build directory
+#include <max_log_map_decoder_pydoc.h>
+
+void bind_max_log_map_decoder(py::module& m)
+{
+
+    using max_log_map_decoder = ::gr::satellites::max_log_map_decoder;
+
+
+    py::class_<max_log_map_decoder,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<max_log_map_decoder>>(
+        m, "max_log_map_decoder", D(max_log_map_decoder))
+
+        .def(py::init(&max_log_map_decoder::make),
+             py::arg("constraint"),
+             py::arg("polynomials"),
+             py::arg("puncturing") = std::vector<int>(),
+             D(max_log_map_decoder, make))
+
+
+        ;
+}
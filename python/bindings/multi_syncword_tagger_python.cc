@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(multi_syncword_tagger.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(7303fc135ab726169a18c9751e836e81)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <satellites/multi_syncword_tagger.h>
+// pydoc.h is automatically generated in the build directory
+#include <multi_syncword_tagger_pydoc.h>
+
+void bind_multi_syncword_tagger(py::module& m)
+{
+
+    using multi_syncword_tagger = ::gr::satellites::multi_syncword_tagger;
+
+
+    py::class_<multi_syncword_tagger,
+               gr::sync_block,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<multi_syncword_tagger>>(
+        m, "multi_syncword_tagger", D(multi_syncword_tagger))
+
+        .def(py::init(&multi_syncword_tagger::make),
+             py::arg("syncwords"),
+             py::arg("thresholds"),
+             py::arg("tag_names"),
+             D(multi_syncword_tagger, make))
+
+
+        ;
+}
@@ -37,6 +37,8 @@ void bind_fixedlen_to_pdu(py::module& m);
 void bind_lilacsat1_demux(py::module& m);
 void bind_manchester_sync(py::module& m);
 void bind_matrix_deinterleaver_soft(py::module& m);
+void bind_max_log_map_decoder(py::module& m);
+void bind_multi_syncword_tagger(py::module& m);
 void bind_nrzi_decode(py::module& m);
 void bind_nrzi_encode(py::module& m);
 void bind_nusat_decoder(py::module& m);
@@ -50,6 +52,7 @@ void bind_u482c_decode(py::module& m);
 void bind_varlen_packet_framer(py::module& m);
 void bind_varlen_packet_tagger(py::module& m);
 void bind_viterbi_decoder(py::module& m);
+void bind_viterbi_decoder_fb(py::module& m);
 // ) END BINDING_FUNCTION_PROTOTYPES
 
 
@@ -94,6 +97,8 @@ PYBIND11_MODULE(satellites_python, m)
     bind_lilacsat1_demux(m);
     bind_manchester_sync(m);
     bind_matrix_deinterleaver_soft(m);
+    bind_max_log_map_decoder(m);
+    bind_multi_syncword_tagger(m);
     bind_nrzi_decode(m);
     bind_nrzi_encode(m);
     bind_nusat_decoder(m);
@@ -107,5 +112,6 @@ PYBIND11_MODULE(satellites_python, m)
     bind_varlen_packet_framer(m);
     bind_varlen_packet_tagger(m);
     bind_viterbi_decoder(m);
+    bind_viterbi_decoder_fb(m);
     // ) END BINDING_FUNCTION_CALLS
 }
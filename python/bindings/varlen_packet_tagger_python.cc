@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(varlen_packet_tagger.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(0ece53d0fe74c0301bf92e4ee6d6b39d)                     */
+/* BINDTOOL_HEADER_FILE_HASH(8f3a338ff2e7f1b487a6a21417683e40)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -46,6 +46,7 @@ void bind_varlen_packet_tagger(py::module& m)
              py::arg("max_packet_size"),
              py::arg("endianness"),
              py::arg("use_golay"),
+             py::arg("packed") = false,
              D(varlen_packet_tagger, make))
 
 
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+/***********************************************************************************/
+/* This file is automatically generated using bindtool and can be manually edited  */
+/* The following lines can be configured to regenerate this file during cmake      */
+/* If manual edits are made, the following tags should be modified accordingly.    */
+/* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
+/* BINDTOOL_USE_PYGCCXML(0)                                                        */
+/* BINDTOOL_HEADER_FILE(viterbi_decoder_fb.h)                                        */
+/* BINDTOOL_HEADER_FILE_HASH(c88ce96246a5f31e89a53fe1bb6fe2b8)                     */
+/***********************************************************************************/
+
+#include <pybind11/complex.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+#include <satellites/viterbi_decoder_fb.h>
+// pydoc.h is automatically generated in the build directory
+#include <viterbi_decoder_fb_pydoc.h>
+
+void bind_viterbi_decoder_fb(py::module& m)
+{
+
+    using viterbi_decoder_fb = ::gr::satellites::viterbi_decoder_fb;
+
+
+    py::class_<viterbi_decoder_fb,
+               gr::sync_decimator,
+               gr::block,
+               gr::basic_block,
+               std::shared_ptr<viterbi_decoder_fb>>(
+        m, "viterbi_decoder_fb", D(viterbi_decoder_fb))
+
+        .def(py::init(&viterbi_decoder_fb::make),
+             py::arg("constraint"),
+             py::arg("polynomials"),
+             py::arg("traceback_depth"),
+             D(viterbi_decoder_fb, make))
+
+
+        ;
+}
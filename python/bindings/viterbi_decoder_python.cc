@@ -14,7 +14,7 @@
 /* BINDTOOL_GEN_AUTOMATIC(0)                                                       */
 /* BINDTOOL_USE_PYGCCXML(0)                                                        */
 /* BINDTOOL_HEADER_FILE(viterbi_decoder.h)                                        */
-/* BINDTOOL_HEADER_FILE_HASH(f90dc54ba31b621d6fe835d643cc9b20)                     */
+/* BINDTOOL_HEADER_FILE_HASH(15668ce303b44daf5ffc21192228c0fa)                     */
 /***********************************************************************************/
 
 #include <pybind11/complex.h>
@@ -41,6 +41,9 @@ void bind_viterbi_decoder(py::module& m)
         .def(py::init(&viterbi_decoder::make),
              py::arg("constraint"),
              py::arg("polynomials"),
+             py::arg("traceback_depth") = 0,
+             py::arg("batch_size") = 1,
+             py::arg("puncturing") = std::vector<int>(),
              D(viterbi_decoder, make))
 
 
@@ -122,6 +122,128 @@ class qa_crc(gr_unittest.TestCase):
         out = pmt.u8vector_elements(pmt.cdr(self.dbg_fail.get_message(0)))
         self.assertEqual(out, self.data)
 
+    def test_crc_check_bit_errors(self):
+        """Test CRC check with bit error correction
+
+        Checks that PDUs with one and two bit errors are corrected and end
+        in the ok port of CRC check, and that a PDU with three bit errors
+        ends in the fail port
+        """
+        crc_params = (32, 0x4C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, True, True)
+        value = crc(*crc_params).compute(self.data)
+        frame = self.data + [(value >> s) & 0xFF for s in (24, 16, 8, 0)]
+        crc_check_block = crc_check(
+            *crc_params, False, False, 0, 2, 64)
+        self.dbg_fail = blocks.message_debug()
+        self.tb.msg_connect((crc_check_block, 'ok'), (self.dbg, 'store'))
+        self.tb.msg_connect((crc_check_block, 'fail'),
+                            (self.dbg_fail, 'store'))
+
+        errors = [[5], [17, 140], [3, 60, 100]]
+        for positions in errors:
+            corrupted = list(frame)
+            for p in positions:
+                corrupted[p // 8] ^= 0x80 >> (p % 8)
+            crc_check_block.to_basic_block()._post(
+                pmt.intern('in'),
+                pmt.cons(pmt.make_dict(),
+                         pmt.init_u8vector(len(corrupted), corrupted)))
+        crc_check_block.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        self.tb.start()
+        self.tb.wait()
+
+        self.assertEqual(self.dbg.num_messages(), 2)
+        for j in range(2):
+            msg = self.dbg.get_message(j)
+            self.assertEqual(pmt.u8vector_elements(pmt.cdr(msg)), frame)
+            meta = pmt.car(msg)
+            self.assertEqual(
+                pmt.to_long(pmt.dict_ref(
+                    meta, pmt.intern('crc_corrected_bits'), pmt.PMT_NIL)),
+                len(errors[j]))
+            self.assertEqual(
+                sorted(pmt.s32vector_elements(pmt.dict_ref(
+                    meta, pmt.intern('crc_corrected_positions'),
+                    pmt.PMT_NIL))),
+                errors[j])
+        self.assertEqual(self.dbg_fail.num_messages(), 1)
+
+    def test_crc_check_ambiguous_bit_errors(self):
+        """Test CRC check with ambiguous bit errors
+
+        Uses a CRC-8 with Hamming distance 3, for which the syndrome of a
+        single bit error is also the syndrome of several pairs of bit
+        errors. Checks that a single bit error is corrected when at most
+        one bit error is corrected, and not corrected when up to two bit
+        errors are corrected.
+        """
+        crc_params = (8, 0x1D, 0x00, 0x00, False, False)
+        frame = self.data + [crc(*crc_params).compute(self.data)]
+        corrupted = list(frame)
+        corrupted[0] ^= 0x04
+        dbg_fail = blocks.message_debug()
+        for max_bit_errors, dbg in [(1, self.dbg), (2, dbg_fail)]:
+            crc_check_block = crc_check(
+                *crc_params, False, False, 0, max_bit_errors, 64)
+            self.tb.msg_connect((crc_check_block, 'ok'), (self.dbg, 'store'))
+            self.tb.msg_connect((crc_check_block, 'fail'),
+                                (dbg_fail, 'store'))
+            crc_check_block.to_basic_block()._post(
+                pmt.intern('in'),
+                pmt.cons(pmt.make_dict(),
+                         pmt.init_u8vector(len(corrupted), corrupted)))
+            crc_check_block.to_basic_block()._post(
+                pmt.intern('system'),
+                pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        self.tb.start()
+        self.tb.wait()
+
+        self.assertEqual(self.dbg.num_messages(), 1)
+        self.assertEqual(
+            pmt.u8vector_elements(pmt.cdr(self.dbg.get_message(0))), frame)
+        self.assertEqual(dbg_fail.num_messages(), 1)
+        self.assertEqual(
+            pmt.u8vector_elements(pmt.cdr(dbg_fail.get_message(0))),
+            corrupted)
+
+    def test_crc_check_ambiguous_bit_pairs(self):
+        """Test CRC check with ambiguous pairs of bit errors
+
+        Uses a CRC-8 with a short period and a 3 byte frame, in which the
+        errors in bit 7 of the CRC and bit 1 of the first byte have the
+        same syndrome as the errors in bits 7 and 0 of the CRC. Checks that
+        the frame is not corrected.
+        """
+        crc_params = (8, 0x39, 0x00, 0x00, False, False)
+        data = [0x12, 0x34]
+        frame = data + [crc(*crc_params).compute(data)]
+        corrupted = list(frame)
+        corrupted[0] ^= 0x02
+        corrupted[2] ^= 0x80
+        crc_check_block = crc_check(
+            *crc_params, False, False, 0, 2, 64)
+        self.dbg_fail = blocks.message_debug()
+        self.tb.msg_connect((crc_check_block, 'ok'), (self.dbg, 'store'))
+        self.tb.msg_connect((crc_check_block, 'fail'),
+                            (self.dbg_fail, 'store'))
+        crc_check_block.to_basic_block()._post(
+            pmt.intern('in'),
+            pmt.cons(pmt.make_dict(),
+                     pmt.init_u8vector(len(corrupted), corrupted)))
+        crc_check_block.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        self.tb.start()
+        self.tb.wait()
+
+        self.assertEqual(self.dbg.num_messages(), 0)
+        self.assertEqual(self.dbg_fail.num_messages(), 1)
+        self.assertEqual(
+            pmt.u8vector_elements(pmt.cdr(self.dbg_fail.get_message(0))),
+            corrupted)
+
     def test_crc_append_crc16_ccitt_zero(self):
         """Test CRC-16-CCITT-Zero calculation"""
         self.run_crc_append(
@@ -181,6 +303,64 @@ class qa_crc_class(gr_unittest.TestCase):
         self.assertEqual(c.compute(list(range(16))),
                          0xD9C908EB)
 
+    @staticmethod
+    def crc_bitwise(data, num_bits, poly, initial_value, final_xor,
+                    input_reflected, result_reflected):
+        """Bit-by-bit reference CRC implementation"""
+        def reflect(x, n):
+            return int(f'{x:0{n}b}'[::-1], 2)
+
+        mask = (1 << num_bits) - 1
+        rem = initial_value & mask
+        for byte in data:
+            if input_reflected:
+                byte = reflect(byte, 8)
+            for j in range(8):
+                bit = ((byte >> (7 - j)) ^ (rem >> (num_bits - 1))) & 1
+                rem = (rem << 1) & mask
+                if bit:
+                    rem ^= poly & mask
+        if result_reflected:
+            rem = reflect(rem, num_bits)
+        return rem ^ (final_xor & mask)
+
+    def test_crc_long_data(self):
+        """Test CRC calculation with data of several lengths"""
+        params = [
+            (8, 0x07, 0x00, 0x00, False, False),
+            (16, 0x1021, 0xFFFF, 0xFFFF, True, True),
+            (16, 0x8005, 0x0000, 0x0000, False, True),
+            (24, 0x864CFB, 0xB704CE, 0x000000, False, False),
+            (32, 0x4C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, True, True),
+            (32, 0x4C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, False, False),
+            (64, 0x42F0E1EBA9EA3693, 0, 0xFFFFFFFFFFFFFFFF, True, True),
+        ]
+        rng = np.random.default_rng(0)
+        for p in params:
+            c = crc(*p)
+            for length in [0, 1, 7, 8, 9, 31, 100, 128, 300, 1000]:
+                data = [int(x) for x in rng.integers(0, 256, length)]
+                self.assertEqual(c.compute(data),
+                                 self.crc_bitwise(data, *p))
+
+    def test_crc_incremental(self):
+        """Test incremental CRC calculation and CRC combination"""
+        c = crc(32, 0x4C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, True, True)
+        rng = np.random.default_rng(0)
+        data = [int(x) for x in rng.integers(0, 256, 500)]
+        expected = c.compute(data)
+        chunks = [data[:3], data[3:200], data[200:]]
+
+        state = c.init()
+        for chunk in chunks:
+            state = c.update(state, chunk)
+        self.assertEqual(c.finalize(state), expected)
+
+        combined = c.compute(chunks[0])
+        for chunk in chunks[1:]:
+            combined = c.combine(combined, c.compute(chunk), len(chunk))
+        self.assertEqual(combined, expected)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_crc)
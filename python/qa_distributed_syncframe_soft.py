@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2026 Daniel Estevez <daniel@destevez.net>
+#
+# This file is part of gr-satellites
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, blocks, gr_unittest
+import numpy as np
+import pmt
+
+# bootstrap satellites module, even from build dir
+try:
+    import python as satellites
+except ImportError:
+    pass
+else:
+    import sys
+    sys.modules['satellites'] = satellites
+
+from satellites import distributed_syncframe_soft
+
+
+class qa_distributed_syncframe_soft(gr_unittest.TestCase):
+    def setUp(self):
+        # AO-40 FEC syncword, which is longer than 64 bits
+        self.syncword = ('11111110000111011110010110010010'
+                         '000001000100110001011101011011000')
+        self.step = 80
+        self.threshold = 4
+        self.frame_len = len(self.syncword) * self.step
+        rng = np.random.default_rng(0)
+        symbols = rng.normal(size=30000).astype('float32')
+        sync = np.array([1.0 if s == '1' else -1.0 for s in self.syncword],
+                        dtype='float32')
+        # The syncs at 1000 and 1001 are interleaved, the one at 9000 has
+        # too many errors, and the one at 27000 is cut by the end of the
+        # stream
+        for pos, errors in [(1000, 0), (1001, self.threshold), (9000, 5),
+                            (15007, 2), (20000, 1), (27000, 0)]:
+            word = sync.copy()
+            flips = rng.choice(word.size, errors, replace=False)
+            word[flips] *= -1
+            frame = symbols[pos:pos+self.frame_len:self.step]
+            frame[:] = word[:frame.size]
+        self.symbols = symbols
+        self.expected_positions = [1000, 1001, 15007, 20000]
+
+    def reference(self, threshold):
+        """Brute force search of the syncword"""
+        sync = np.array([int(s) for s in self.syncword], dtype='uint8')
+        num_candidates = self.symbols.size - self.frame_len + 1
+        candidates = (np.arange(num_candidates)[:, np.newaxis]
+                      + self.step * np.arange(sync.size))
+        bits = (self.symbols[candidates] >= 0).astype('uint8')
+        errors = np.sum(bits != sync, axis=1)
+        positions = np.where(errors <= threshold)[0]
+        return positions, [self.symbols[p:p+self.frame_len]
+                           for p in positions]
+
+    def run_block(self, threshold, max_items=None):
+        source = blocks.vector_source_f(self.symbols, False)
+        if max_items is not None:
+            source.set_max_noutput_items(max_items)
+        deframer = distributed_syncframe_soft(
+            threshold, self.syncword, self.step)
+        debug = blocks.message_debug()
+        tb = gr.top_block()
+        tb.connect(source, deframer)
+        tb.msg_connect((deframer, 'out'), (debug, 'store'))
+        tb.start()
+        tb.wait()
+        return [np.array(pmt.f32vector_elements(
+                    pmt.cdr(debug.get_message(j))), dtype='float32')
+                for j in range(debug.num_messages())]
+
+    def test_reference(self):
+        """Checks that the test data has the expected syncs"""
+        positions, _ = self.reference(self.threshold)
+        np.testing.assert_equal(positions, self.expected_positions)
+        positions, _ = self.reference(0)
+        np.testing.assert_equal(positions, [1000])
+
+    def test_syncframes(self):
+        """Compares the frames with a brute force search of the syncword"""
+        for threshold in [0, self.threshold]:
+            _, expected = self.reference(threshold)
+            # The syncframes span many calls to work() when the input
+            # is delivered in small chunks
+            for max_items in [None, 1000, 77]:
+                with self.subTest(threshold=threshold, max_items=max_items):
+                    pdus = self.run_block(threshold, max_items)
+                    self.assertEqual(len(pdus), len(expected))
+                    for pdu, frame in zip(pdus, expected):
+                        np.testing.assert_equal(pdu, frame)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_distributed_syncframe_soft)
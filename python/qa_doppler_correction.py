@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2026 Daniel Estevez <daniel@destevez.net>
+#
+# This file is part of gr-satellites
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+import importlib.util
+import os
+import tempfile
+
+from gnuradio import gr, blocks, gr_unittest
+import numpy as np
+import pmt
+
+# bootstrap satellites module, even from build dir
+try:
+    import python as satellites
+except ImportError:
+    pass
+else:
+    import sys
+    sys.modules['satellites'] = satellites
+
+from satellites import doppler_correction
+
+
+def load_converter():
+    """Loads the script that converts text Doppler files to binary files"""
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..',
+                        'examples', 'doppler_correction',
+                        'doppler_file_to_binary.py')
+    spec = importlib.util.spec_from_file_location(
+        'doppler_file_to_binary', path)
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def rx_time(t):
+    return pmt.make_tuple(pmt.from_uint64(int(t)), pmt.from_double(t % 1))
+
+
+class qa_doppler_correction(gr_unittest.TestCase):
+    def setUp(self):
+        self.samp_rate = 10e3
+        self.t0 = 99.5
+        rng = np.random.default_rng(0)
+        self.times = 100 + np.cumsum(rng.uniform(0.01, 0.3, 50))
+        self.freqs = rng.uniform(-2000, 2000, self.times.size)
+        self.dir = tempfile.TemporaryDirectory()
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def run_doppler_correction(self, path, nsamples, time_tags=()):
+        tags = [gr.python_to_tag((offset, pmt.intern('rx_time'),
+                                  rx_time(t), pmt.intern('test_src')))
+                for offset, t in time_tags]
+        source = blocks.vector_source_c(np.ones(nsamples), False, 1, tags)
+        sink = blocks.vector_sink_c()
+        block = doppler_correction(path, self.samp_rate, self.t0)
+        if time_tags:
+            # The time tags are applied to all the samples in a call to
+            # work(), so the calls are aligned to the offsets of the tags
+            source.set_max_noutput_items(self.chunk)
+            block.set_max_noutput_items(self.chunk)
+        tb = gr.top_block()
+        tb.connect(source, block, sink)
+        tb.run()
+        return np.array(sink.data())
+
+    def expected(self, nsamples, time_tags=()):
+        t = self.t0 + np.arange(nsamples) / self.samp_rate
+        for offset, time in time_tags:
+            t[offset:] = time + np.arange(nsamples - offset) / self.samp_rate
+        f = np.interp(t, self.times, self.freqs)
+        return np.exp(-1j * np.cumsum(2 * np.pi * f / self.samp_rate))
+
+    def write_text_file(self):
+        path = os.path.join(self.dir.name, 'doppler.txt')
+        with open(path, 'w') as f:
+            for t, freq in zip(self.times, self.freqs):
+                print(f'{float(t)!r} {float(freq)!r}', file=f)
+        return path
+
+    def write_binary_file(self):
+        """Converts the text file to a binary file with the example script"""
+        converter = load_converter()
+        path = os.path.join(self.dir.name, 'doppler.bin')
+        converter.write_binary_file(
+            path, *converter.read_text_file(self.write_text_file()))
+        return path
+
+    def test_text_file(self):
+        """Test Doppler correction with a text file"""
+        nsamples = int(self.samp_rate * (self.times[-1] - self.t0 + 1))
+        out = self.run_doppler_correction(self.write_text_file(), nsamples)
+        np.testing.assert_allclose(out, self.expected(nsamples), atol=1e-3)
+
+    def test_binary_file(self):
+        """Test Doppler correction with a binary file
+
+        Checks that the output matches the one obtained with the same
+        Doppler data in a text file.
+        """
+        nsamples = int(self.samp_rate * (self.times[-1] - self.t0 + 1))
+        out_text = self.run_doppler_correction(
+            self.write_text_file(), nsamples)
+        out_binary = self.run_doppler_correction(
+            self.write_binary_file(), nsamples)
+        np.testing.assert_allclose(out_binary, out_text, atol=1e-4)
+        np.testing.assert_allclose(
+            out_binary, self.expected(nsamples), atol=1e-3)
+
+
+    def test_time_jumps(self):
+        """Test Doppler correction with time jumps
+
+        Uses rx_time tags that jump forward and backward by several
+        entries of the Doppler file, and checks that the outputs with a
+        text file and a binary file match each other and the expected
+        output.
+        """
+        self.chunk = 1024
+        nsamples = 10 * self.chunk
+        time_tags = [(2 * self.chunk, self.times[30] + 0.05),
+                     (6 * self.chunk, self.times[5] - 0.02),
+                     (8 * self.chunk, self.times[-1] + 0.5)]
+        out_text = self.run_doppler_correction(
+            self.write_text_file(), nsamples, time_tags)
+        out_binary = self.run_doppler_correction(
+            self.write_binary_file(), nsamples, time_tags)
+        np.testing.assert_allclose(out_binary, out_text, atol=1e-4)
+        np.testing.assert_allclose(
+            out_binary, self.expected(nsamples, time_tags), atol=1e-3)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_doppler_correction)
@@ -22,7 +22,7 @@ else:
     sys.modules['satellites'] = satellites
 
 from satellites import fixedlen_to_pdu
-from satellites.grtypes import byte_t
+from satellites.grtypes import byte_t, float_t
 
 
 class qa_fixedlen_tagger(gr_unittest.TestCase):
@@ -61,6 +61,53 @@ class qa_fixedlen_tagger(gr_unittest.TestCase):
             np.testing.assert_equal(pdu, expected,
                                     'PDU values do not match expected')
 
+    def run_block(self, source, block):
+        debug = blocks.message_debug()
+        tb = gr.top_block()
+        tb.connect(source, block)
+        tb.msg_connect((block, 'pdus'), (debug, 'store'))
+        tb.start()
+        tb.wait()
+        self.assertEqual(debug.num_messages(), len(self.tag_positions),
+                         'Unexpected number of PDUs')
+        return [pmt.cdr(debug.get_message(j))
+                for j in range(len(self.tag_positions))]
+
+    def tags(self):
+        return [gr.python_to_tag((j, pmt.intern(self.syncword_tag),
+                                  pmt.intern('sync'), pmt.intern('test_src')))
+                for j in self.tag_positions]
+
+    def test_pack(self):
+        """Checks the PDUs of Fixedlen to PDU with bit packing"""
+        rng = np.random.default_rng(0)
+        bits = rng.integers(0, 2, self.data.size, dtype='uint8')
+        source = blocks.vector_source_b(bits, False, 1, self.tags())
+        block = fixedlen_to_pdu(
+            byte_t, self.syncword_tag, self.packet_len * 8, True)
+        pdus = self.run_block(source, block)
+        for pdu, pos in zip(pdus, self.tag_positions):
+            expected = np.packbits(bits[pos:pos+self.packet_len*8])
+            np.testing.assert_equal(
+                np.array(pmt.u8vector_elements(pdu), dtype='uint8'),
+                expected, 'PDU values do not match expected')
+
+    def test_quantize(self):
+        """Checks the PDUs of Fixedlen to PDU with int8 quantization"""
+        scale = 20.0
+        rng = np.random.default_rng(0)
+        soft = rng.normal(size=self.data.size).astype('float32')
+        source = blocks.vector_source_f(soft, False, 1, self.tags())
+        block = fixedlen_to_pdu(
+            float_t, self.syncword_tag, self.packet_len, False, True, scale)
+        pdus = self.run_block(source, block)
+        for pdu, pos in zip(pdus, self.tag_positions):
+            expected = np.clip(np.rint(soft[pos:pos+self.packet_len] * scale),
+                               -128, 127)
+            np.testing.assert_equal(
+                np.array(pmt.s8vector_elements(pdu)), expected,
+                'PDU values do not match expected')
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_fixedlen_tagger)
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2026 Daniel Estevez <daniel@destevez.net>
+#
+# This file is part of gr-satellites
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, blocks, digital, gr_unittest
+import numpy as np
+import pmt
+
+# bootstrap satellites module, even from build dir
+try:
+    import python as satellites
+except ImportError:
+    pass
+else:
+    import sys
+    sys.modules['satellites'] = satellites
+
+from satellites import multi_syncword_tagger
+
+
+class qa_multi_syncword_tagger(gr_unittest.TestCase):
+    def setUp(self):
+        self.syncwords = [
+            '00011010110011111111110000011101',
+            '0111111001111110',
+            '1100101000101110101001011001110110011010110000010110010101011000',
+        ]
+        self.thresholds = [4, 0, 8]
+        self.tag_names = ['ccsds', 'flags', 'long']
+        rng = np.random.default_rng(0)
+        symbols = rng.normal(size=20000).astype('float32')
+        for j, syncword in enumerate(self.syncwords):
+            for pos in rng.integers(0, symbols.size - 64, 10):
+                symbols[pos:pos+len(syncword)] = [
+                    1.0 if s == '1' else -1.0 for s in syncword]
+        self.symbols = symbols
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def get_tags(self, sink):
+        return sorted((tag.offset, pmt.symbol_to_string(tag.key),
+                       pmt.to_long(tag.value))
+                      for tag in sink.tags())
+
+    def test_tags(self):
+        """Checks that the tags match those of Correlate Access Code - Tag"""
+        source = blocks.vector_source_f(self.symbols, False)
+        tagger = multi_syncword_tagger(
+            self.syncwords, self.thresholds, self.tag_names)
+        sink = blocks.vector_sink_f()
+        self.tb.connect(source, tagger, sink)
+        reference_sinks = []
+        for syncword, threshold, name in zip(
+                self.syncwords, self.thresholds, self.tag_names):
+            correlator = digital.correlate_access_code_tag_ff(
+                syncword, threshold, name)
+            reference_sink = blocks.vector_sink_f()
+            self.tb.connect(source, correlator, reference_sink)
+            reference_sinks.append(reference_sink)
+        self.tb.start()
+        self.tb.wait()
+
+        np.testing.assert_equal(np.array(sink.data(), dtype='float32'),
+                                self.symbols)
+        expected = sorted(sum((self.get_tags(s) for s in reference_sinks),
+                              []))
+        self.assertEqual(self.get_tags(sink), expected)
+        self.assertGreaterEqual(len(expected), 30)
+
+    def test_wrong_parameters(self):
+        """Checks that invalid parameters are rejected"""
+        with self.assertRaises(RuntimeError):
+            multi_syncword_tagger(['0101'], [1, 2], ['a'])
+        with self.assertRaises(RuntimeError):
+            multi_syncword_tagger(['01' * 33], [1], ['a'])
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_multi_syncword_tagger)
@@ -75,6 +75,103 @@ class qa_rs(gr_unittest.TestCase):
         self.decode = decode_rs(8, 0x11d, 1, 1, 16, 1)
         self.data = np.random.randint(0, 256, 255 - 16, dtype='uint8')
 
+    def test_custom_rs_many_roots(self):
+        interleave = 3
+        self.encode = encode_rs(8, 0x11d, 1, 1, 48, interleave)
+        self.decode = decode_rs(8, 0x11d, 1, 1, 48, interleave)
+        self.data = np.random.randint(0, 256, 200 * interleave, dtype='uint8')
+
+
+class qa_rs_errors(gr_unittest.TestCase):
+    def setUp(self):
+        self.rng = np.random.default_rng(0)
+
+    def encode_data(self, encode, data):
+        tb = gr.top_block()
+        dbg = blocks.message_debug()
+        tb.msg_connect((encode, 'out'), (dbg, 'store'))
+        encode.to_basic_block()._post(
+            pmt.intern('in'),
+            pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(data), data)))
+        encode.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+        return np.array(pmt.u8vector_elements(pmt.cdr(dbg.get_message(0))))
+
+    def decode_pdus(self, decode, pdus):
+        tb = gr.top_block()
+        dbg = blocks.message_debug()
+        tb.msg_connect((decode, 'out'), (dbg, 'store'))
+        for pdu in pdus:
+            decode.to_basic_block()._post(pmt.intern('in'), pdu)
+        decode.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+        return [dbg.get_message(j) for j in range(dbg.num_messages())]
+
+    def test_interleave_errors(self):
+        interleave = 5
+        data = self.rng.integers(0, 256, 223 * interleave, dtype='uint8')
+        codeword = self.encode_data(encode_rs(True, interleave), data)
+        # Errors only in interleaver paths 1 and 3
+        for path, num_errors in [(1, 16), (3, 5)]:
+            positions = interleave * self.rng.choice(
+                255, num_errors, replace=False) + path
+            codeword[positions] ^= self.rng.integers(
+                1, 256, num_errors, dtype='uint8')
+        msgs = self.decode_pdus(
+            decode_rs(True, interleave),
+            [pmt.cons(pmt.PMT_NIL,
+                      pmt.init_u8vector(len(codeword), codeword))])
+        self.assertEqual(len(msgs), 1)
+        np.testing.assert_equal(data, pmt.u8vector_elements(pmt.cdr(msgs[0])),
+                                'Decoded data does not match encoder input')
+        rs_errors = pmt.to_long(
+            pmt.dict_ref(pmt.car(msgs[0]), pmt.intern('rs_errors'),
+                         pmt.PMT_NIL))
+        self.assertEqual(rs_errors, 21)
+
+    def test_erasures(self):
+        data = self.rng.integers(0, 256, 223, dtype='uint8')
+        codeword = self.encode_data(encode_rs(False, 1), data)
+
+        # Corrupt more bytes than can be corrected without erasures,
+        # giving them low reliability
+        corrupted = self.rng.choice(codeword.size, 24, replace=False)
+        codeword[corrupted] ^= self.rng.integers(
+            1, 256, corrupted.size, dtype='uint8')
+        reliability = np.ones(codeword.size, 'float32')
+        reliability[corrupted] = 0.1
+        soft = 2 * np.unpackbits(codeword).astype('float32') - 1
+        soft *= np.repeat(reliability, 8)
+        pdus = [
+            pmt.cons(pmt.PMT_NIL, pmt.init_f32vector(len(soft), soft)),
+            pmt.cons(
+                pmt.dict_add(pmt.make_dict(), pmt.intern('rs_reliability'),
+                             pmt.init_f32vector(len(reliability),
+                                                reliability)),
+                pmt.init_u8vector(len(codeword), codeword)),
+            pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(codeword), codeword)),
+        ]
+
+        msgs = self.decode_pdus(decode_rs(False, 1), pdus)
+
+        # The PDU without reliability cannot be decoded
+        self.assertEqual(len(msgs), 2)
+        for msg in msgs:
+            np.testing.assert_equal(
+                data, pmt.u8vector_elements(pmt.cdr(msg)),
+                'Decoded data does not match encoder input')
+            erasures = pmt.to_long(
+                pmt.dict_ref(pmt.car(msg), pmt.intern('rs_erasures'),
+                             pmt.PMT_NIL))
+            self.assertGreaterEqual(erasures, corrupted.size)
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_rs)
+    gr_unittest.run(qa_rs_errors)
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright 2026 Daniel Estevez <daniel@destevez.net>
+#
+# This file is part of gr-satellites
+#
+# SPDX-License-Identifier: GPL-3.0-or-later
+#
+
+from gnuradio import gr, blocks, gr_unittest
+import numpy as np
+import pmt
+
+# bootstrap satellites module, even from build dir
+try:
+    import python as satellites
+except ImportError:
+    pass
+else:
+    import sys
+    sys.modules['satellites'] = satellites
+
+from satellites import varlen_packet_tagger
+
+
+# Parity check matrix used by lib/golay24.c
+GOLAY_H = [0x8008ed, 0x4001db, 0x2003b5, 0x100769, 0x80ed1, 0x40da3,
+           0x20b47, 0x1068f, 0x8d1d, 0x4a3b, 0x2477, 0x1ffe]
+
+
+def golay_encode(data):
+    parity = 0
+    for h in GOLAY_H:
+        parity = (parity << 1) | (bin(h & data).count('1') & 1)
+    return (parity << 12) | data
+
+
+def golay_distance(word):
+    """Distance from word to the closest Golay codeword"""
+    return min(bin(word ^ golay_encode(data)).count('1')
+               for data in range(4096))
+
+
+def field_bits(value, size, msb_first=True):
+    bits = [(value >> j) & 1 for j in range(size)]
+    return bits[::-1] if msb_first else bits
+
+
+class qa_varlen_packet_tagger(gr_unittest.TestCase):
+    def setUp(self):
+        self.syncword_tag = 'syncword'
+        self.packetlen_tag = 'packet_len'
+        self.rng = np.random.default_rng(0)
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def random_bits(self, size):
+        return self.rng.integers(2, size=size, dtype='uint8')
+
+    def place(self, bits, position, header, payload):
+        """Writes a header and payload to bits and returns the payload"""
+        bits[position:position+len(header)] = header
+        start = position + len(header)
+        bits[start:start+len(payload)] = payload
+        return np.array(payload, dtype='uint8')
+
+    def run_tagger(self, data, syncs, length_field_size, mtu,
+                   endianness=gr.GR_MSB_FIRST, use_golay=False,
+                   packed=False, max_items=None):
+        tags = [gr.python_to_tag((j, pmt.intern(self.syncword_tag),
+                                  pmt.intern('sync'), pmt.intern('test_src')))
+                for j in syncs]
+        source = blocks.vector_source_b(data, False, 1, tags)
+        tagger = varlen_packet_tagger(
+            self.syncword_tag, self.packetlen_tag, length_field_size,
+            mtu, endianness, use_golay, packed)
+        sink = blocks.vector_sink_b()
+        if max_items is not None:
+            # Deliver the input in small chunks, so that packets are split
+            # across calls, and give the tagger room for a single packet
+            source.set_max_noutput_items(max_items)
+            tagger.set_max_noutput_items(mtu // 8 if packed else mtu)
+        self.tb.connect(source, tagger, sink)
+        self.tb.run()
+        output = np.array(sink.data(), dtype='uint8')
+        tags = sorted((tag.offset, pmt.to_long(tag.value))
+                      for tag in sink.tags()
+                      if pmt.symbol_to_string(tag.key) == self.packetlen_tag)
+        return output, tags
+
+    def check(self, output, tags, packets):
+        expected_tags = []
+        offset = 0
+        for packet in packets:
+            expected_tags.append((offset, packet.size))
+            offset += packet.size
+        self.assertEqual(tags, expected_tags)
+        np.testing.assert_equal(output, np.concatenate(packets))
+
+    def several_packets(self, endianness):
+        bits = self.random_bits(400)
+        packets = []
+        for position, length in [(10, 3), (50, 2), (80, 1), (100, 1),
+                                 (130, 25)]:
+            header = field_bits(length, 8, endianness == gr.GR_MSB_FIRST)
+            packets.append(self.place(bits, position, header,
+                                      self.random_bits(8 * length)))
+        # The packet at 130 does not fit in the MTU and the packet at 380
+        # is truncated by the end of the stream
+        packets.pop()
+        header = field_bits(4, 8, endianness == gr.GR_MSB_FIRST)
+        bits[380:388] = header
+        syncs = [10, 50, 80, 100, 130, 380]
+        return bits, syncs, packets
+
+    def test_several_packets(self):
+        """Checks several packets and syncs in the same input window"""
+        bits, syncs, packets = self.several_packets(gr.GR_MSB_FIRST)
+        output, tags = self.run_tagger(bits, syncs, 8, 64)
+        self.check(output, tags, packets)
+
+    def test_lsb_first(self):
+        """Checks a little-endian length field"""
+        bits, syncs, packets = self.several_packets(gr.GR_LSB_FIRST)
+        output, tags = self.run_tagger(bits, syncs, 8, 64,
+                                       endianness=gr.GR_LSB_FIRST)
+        self.check(output, tags, packets)
+
+    def test_small_chunks(self):
+        """Checks packets split across calls and a small output buffer"""
+        bits, syncs, packets = self.several_packets(gr.GR_MSB_FIRST)
+        output, tags = self.run_tagger(bits, syncs, 8, 64, max_items=5)
+        self.check(output, tags, packets)
+
+    def test_syncs_inside_packets(self):
+        """Checks that syncs in a header are skipped and in a payload tried"""
+        bits = self.random_bits(400)
+        payload = self.random_bits(32)
+        # Another packet with a 1 byte payload starts in the middle
+        # of the payload of the first packet
+        payload[12:20] = field_bits(1, 8)
+        first = self.place(bits, 10, field_bits(4, 8), payload)
+        second = payload[20:28]
+        # The sync at 13 is inside the header of the first packet,
+        # and the sync at 10 is repeated
+        syncs = [10, 10, 13, 30]
+        # The MTU is large enough for the length read at 13 to give a
+        # packet if the sync was not skipped
+        output, tags = self.run_tagger(bits, syncs, 8, 320)
+        self.check(output, tags, [first, second])
+
+    def test_golay_and_mtu_failures(self):
+        """Checks Golay and MTU failures followed by valid syncs"""
+        bits = self.random_bits(300)
+        packets = []
+        # A packet with a correctable error in its header, whose
+        # header overlaps an uncorrectable header that starts at 20
+        header = field_bits(golay_encode(2) ^ 0x000400, 24)
+        packets.append(self.place(bits, 30, header, self.random_bits(16)))
+        for j in range(1 << 10):
+            bits[20:30] = field_bits(j, 10)
+            word = int(''.join(str(b) for b in bits[20:44]), 2)
+            if golay_distance(word) > 3:
+                break
+        else:
+            self.fail('no uncorrectable Golay header found')
+        # A packet longer than the MTU followed by a valid packet
+        bits[100:124] = field_bits(golay_encode(20), 24)
+        header = field_bits(golay_encode(3), 24)
+        packets.append(self.place(bits, 150, header, self.random_bits(24)))
+        syncs = [20, 30, 100, 150]
+        output, tags = self.run_tagger(bits, syncs, 0, 64, use_golay=True)
+        self.check(output, tags, packets)
+
+    def test_packed(self):
+        """Checks packed bytes with a length field that is not byte aligned"""
+        bits = self.random_bits(8 * 100)
+        packets = []
+        syncs = [2, 10, 30, 31, 60, 97]
+        for position, length in [(2, 5), (10, 12), (30, 2), (60, 30)]:
+            header = field_bits(length, 12)
+            packets.append(self.place(bits, 8 * position, header,
+                                      self.random_bits(8 * length)))
+        # The packet at 60 exceeds the MTU and the packet at 97 is
+        # truncated by the end of the stream
+        packets.pop()
+        bits[8*97:8*97+12] = field_bits(4, 12)
+        # The sync at 31 is inside the header of the packet at 30
+        data = np.packbits(bits)
+        expected = [np.packbits(p) for p in packets]
+        for max_items in [None, 3]:
+            with self.subTest(max_items=max_items):
+                self.tb = gr.top_block()
+                output, tags = self.run_tagger(data, syncs, 12, 8 * 16,
+                                               packed=True,
+                                               max_items=max_items)
+                self.check(output, tags, expected)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_varlen_packet_tagger)
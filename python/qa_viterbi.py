@@ -21,10 +21,15 @@ else:
     import sys
     sys.modules['satellites'] = satellites
 
-from satellites import convolutional_encoder, viterbi_decoder
+from satellites import (
+    convolutional_encoder, max_log_map_decoder, viterbi_decoder,
+    viterbi_decoder_fb)
 
 
 class qa_viterbi(gr_unittest.TestCase):
+    def setUp(self):
+        self.rng = np.random.default_rng(0)
+
     def test_viterbi(self):
         tb = gr.top_block()
         dbg = blocks.message_debug()
@@ -50,6 +55,182 @@ class qa_viterbi(gr_unittest.TestCase):
             out, np.array(data),
             'Encoded and decoded message does not match original')
 
+    def encode(self, k, p, data, puncturing=[], packed_input=False,
+               packed_output=False):
+        tb = gr.top_block()
+        dbg = blocks.message_debug()
+        enc = convolutional_encoder(k, p, puncturing, packed_input,
+                                    packed_output)
+        pdu = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(data), data))
+        tb.msg_connect((enc, 'out'), (dbg, 'store'))
+        enc.to_basic_block()._post(pmt.intern('in'), pdu)
+        enc.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+        return np.array(pmt.u8vector_elements(pmt.cdr(dbg.get_message(0))))
+
+    def test_convolutional_encoder_packed(self):
+        k = 7
+        p = [79, 109]
+        data = self.rng.integers(2, size=1003, dtype='uint8')
+        packed_data = np.packbits(data)
+        for puncturing in [[], [1, 1, 0, 1]]:
+            coded = self.encode(k, p, data, puncturing)
+            packed_coded = np.packbits(coded)
+            np.testing.assert_equal(
+                self.encode(k, p, data, puncturing, packed_output=True),
+                packed_coded,
+                'Packed output does not match unpacked output')
+            # The packed input contains 5 additional zero bits, which
+            # produce len(p) * 5 additional symbols
+            whole_bytes = self.encode(k, p, packed_data, puncturing,
+                                      packed_input=True)
+            np.testing.assert_equal(
+                whole_bytes,
+                self.encode(k, p, np.unpackbits(packed_data), puncturing),
+                'Packed input does not match unpacked input')
+
+    def decode_soft(self, k, p, soft, traceback_depth=0, puncturing=[]):
+        tb = gr.top_block()
+        dbg = blocks.message_debug()
+        dec = viterbi_decoder(k, p, traceback_depth, puncturing=puncturing)
+        tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        dec.to_basic_block()._post(
+            pmt.intern('in'),
+            pmt.cons(pmt.PMT_NIL, pmt.init_f32vector(len(soft), soft)))
+        dec.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+        return pmt.u8vector_elements(pmt.cdr(dbg.get_message(0)))
+
+    def noisy_symbols(self, k, p, data, puncturing=[], noise=0.5):
+        coded = self.encode(k, p, data, puncturing)
+        soft = 2 * coded.astype('float32') - 1
+        soft += noise * self.rng.normal(size=soft.size).astype('float32')
+        return soft
+
+    def test_viterbi_soft(self):
+        k = 7
+        p = [79, 109]
+        data = self.rng.integers(2, size=1000, dtype='uint8')
+        out = self.decode_soft(k, p, self.noisy_symbols(k, p, data))
+        np.testing.assert_equal(
+            out, data,
+            'Soft decoded message does not match original')
+
+    def test_viterbi_traceback_depth(self):
+        k = 7
+        p = [79, 109]
+        data = self.rng.integers(2, size=5000, dtype='uint8')
+        out = self.decode_soft(k, p, self.noisy_symbols(k, p, data),
+                               traceback_depth=5*k)
+        np.testing.assert_equal(
+            out, data,
+            'Sliding window decoded message does not match original')
+
+    def test_viterbi_punctured(self):
+        k = 7
+        p = [79, 109]
+        data = self.rng.integers(2, size=1000, dtype='uint8')
+        for puncturing in [[1, 1, 0, 1], [1, 1, 0, 1, 1, 0]]:
+            coded = self.encode(k, p, data, puncturing)
+            rate = sum(puncturing) / len(puncturing)
+            self.assertAlmostEqual(
+                coded.size, len(p) * (data.size + k - 1) * rate, delta=2)
+            soft = self.noisy_symbols(k, p, data, puncturing, noise=0.3)
+            out = self.decode_soft(k, p, soft, puncturing=puncturing)
+            np.testing.assert_equal(
+                out, data,
+                'Punctured decoded message does not match original')
+
+    def test_viterbi_batch(self):
+        k = 7
+        p = [79, 109]
+        # Lengths chosen so that there are runs of PDUs of the same
+        # length that span several groups of SIMD lanes
+        lengths = [500] * 20 + [300] * 3 + [500] * 2
+        datas = [self.rng.integers(2, size=n, dtype='uint8')
+                 for n in lengths]
+        symbols = [self.noisy_symbols(k, p, data) for data in datas]
+
+        tb = gr.top_block()
+        dbg = blocks.message_debug()
+        dec = viterbi_decoder(k, p, batch_size=32)
+        tb.msg_connect((dec, 'out'), (dbg, 'store'))
+        for s in symbols:
+            dec.to_basic_block()._post(
+                pmt.intern('in'),
+                pmt.cons(pmt.PMT_NIL, pmt.init_f32vector(len(s), s)))
+        dec.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+
+        self.assertEqual(dbg.num_messages(), len(datas))
+        for j, data in enumerate(datas):
+            out = pmt.u8vector_elements(pmt.cdr(dbg.get_message(j)))
+            np.testing.assert_equal(
+                out, data,
+                'Batch decoded message does not match original')
+
+    def test_max_log_map_decoder(self):
+        k = 7
+        p = [79, 109]
+        data = self.rng.integers(2, size=1000, dtype='uint8')
+        soft = self.noisy_symbols(k, p, data)
+
+        tb = gr.top_block()
+        dbg_out = blocks.message_debug()
+        dbg_llr = blocks.message_debug()
+        dec = max_log_map_decoder(k, p)
+        tb.msg_connect((dec, 'out'), (dbg_out, 'store'))
+        tb.msg_connect((dec, 'llr'), (dbg_llr, 'store'))
+        dec.to_basic_block()._post(
+            pmt.intern('in'),
+            pmt.cons(pmt.PMT_NIL, pmt.init_f32vector(len(soft), soft)))
+        dec.to_basic_block()._post(
+            pmt.intern('system'),
+            pmt.cons(pmt.intern('done'), pmt.from_long(1)))
+        tb.start()
+        tb.wait()
+
+        out = pmt.u8vector_elements(pmt.cdr(dbg_out.get_message(0)))
+        llr = np.array(pmt.f32vector_elements(
+            pmt.cdr(dbg_llr.get_message(0))))
+        np.testing.assert_equal(
+            out, data,
+            'Max-Log-MAP decoded message does not match original')
+        np.testing.assert_equal(
+            (llr > 0).astype('uint8'), data,
+            'Max-Log-MAP LLR signs do not match original')
+
+    def test_viterbi_decoder_fb(self):
+        k = 7
+        p = [79, 109]
+        depth = 5 * k
+        data = self.rng.integers(2, size=5000, dtype='uint8')
+        delay = 2 * depth - 1
+        soft = self.noisy_symbols(k, p, data)
+        # Append erasures to flush the decoder
+        soft = np.concatenate((soft, np.zeros(len(p) * delay, 'float32')))
+
+        tb = gr.top_block()
+        src = blocks.vector_source_f(soft)
+        dec = viterbi_decoder_fb(k, p, depth)
+        dst = blocks.vector_sink_b()
+        tb.connect(src, dec, dst)
+        tb.run()
+
+        out = np.array(dst.data())[delay:delay + data.size]
+        np.testing.assert_equal(
+            out, data,
+            'Streaming decoded message does not match original')
+
 
 if __name__ == '__main__':
     gr_unittest.run(qa_viterbi)